@@ -19,6 +19,8 @@
  */
 
 #pragma once
+#include <chrono>
+#include <cstddef>
 #include <string>
 #include "base/logging/logging_types.h"
 #include "logging_types_legacy.h"
@@ -49,6 +51,67 @@ public:
         const std::string& participant_name,
         const std::string& logger_name, //depends on the Category ... 
         const std::string& message) = 0;
+
+    /**
+     * @brief Callback on the start of a transition (i.e. "initialize") at the participants of the system
+     *
+     * The progress callbacks are delivered asynchronously by one thread of the system in order of their occurrence,
+     * so a slow callback does not delay the transition (but the following callbacks).
+     * They are not synchronized with @ref onLog.
+     * If the participants of one call (i.e. fep3::System::setSystemState) need different transitions,
+     * the transitions are reported side by side.
+     *
+     * @param transition name of the transition (see fep3::System::getTransitionLatencies)
+     * @param participant_count count of the participants called
+     */
+    virtual void onTransitionStarted(const std::string& /*transition*/, size_t /*participant_count*/)
+    {
+    }
+
+    /**
+     * @brief Callback on every participant which answered a transition (or did not answer in time)
+     *
+     * @param transition name of the transition
+     * @param participant_name name of the participant
+     * @param successful true if the participant changed its state, false if it failed or did not answer in time
+     * @param duration the duration of the transition at the participant
+     * @param finished_count count of the participants which answered this transition so far (including this one)
+     * @param participant_count count of the participants called
+     */
+    virtual void onParticipantTransitionFinished(const std::string& /*transition*/,
+        const std::string& /*participant_name*/,
+        bool /*successful*/,
+        std::chrono::microseconds /*duration*/,
+        size_t /*finished_count*/,
+        size_t /*participant_count*/)
+    {
+    }
+
+    /**
+     * @brief Callback on the end of a transition at the participants of the system
+     *
+     * @param transition name of the transition
+     * @param successful true if every participant changed its state
+     * @param duration the duration of the whole transition
+     */
+    virtual void onTransitionFinished(const std::string& /*transition*/,
+        bool /*successful*/,
+        std::chrono::microseconds /*duration*/)
+    {
+    }
+
+    /**
+     * @brief Callback on every participant which became unreachable or reachable again,
+     * detected by the health monitor (see fep3::System::setHealthMonitor)
+     *
+     * Delivered like the progress callbacks (see @ref onTransitionStarted).
+     *
+     * @param participant_name name of the participant
+     * @param reachable true if the participant is reachable again, false if it became unreachable
+     */
+    virtual void onParticipantReachabilityChanged(const std::string& /*participant_name*/, bool /*reachable*/)
+    {
+    }
 };
 
 
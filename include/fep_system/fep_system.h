@@ -24,8 +24,10 @@
 #include <string>
 #include <map>
 #include <chrono>
+#include <vector>
 #include "fep_system_types.h"
 #include "participant_proxy.h"
+#include "system_operation.h"
 #include "base/logging/logging_types.h"
 #include "logging_types_legacy.h"
 #include "event_monitor_intf.h"
@@ -34,6 +36,30 @@
 #define FEP_SYSTEM_DEFAULT_TIMEOUT std::chrono::milliseconds(500)
 ///The fep::System state transition timeout for every fep3::System call that need to change the states of the participants
 #define FEP_SYSTEM_TRANSITION_TIMEOUT std::chrono::milliseconds(10000)
+///The fep::System default of participants which are shut down at the same time
+#define FEP_SYSTEM_SHUTDOWN_CONCURRENCY 8
+///The fep::System default interval of the reconciliation of the state mirror (see fep3::System::setStateMirror)
+#define FEP_SYSTEM_STATE_RECONCILIATION_INTERVAL std::chrono::milliseconds(5000)
+///The fep::System default of the maximum age of the state mirror answering fep3::System::getSystemState (see fep3::System::setStateMirror)
+#define FEP_SYSTEM_STATE_MIRROR_MAX_STALENESS std::chrono::milliseconds(10000)
+///The fep::System default of the shortest interval of the health monitor (see fep3::System::setHealthMonitor)
+#define FEP_SYSTEM_HEALTH_CHECK_MIN_INTERVAL std::chrono::milliseconds(500)
+///The fep::System default of the longest interval of the health monitor (see fep3::System::setHealthMonitor)
+#define FEP_SYSTEM_HEALTH_CHECK_MAX_INTERVAL std::chrono::milliseconds(4000)
+///The fep::System default count of the latest calls of each participant and transition kept in the latency history (see fep3::System::getTransitionLatencies)
+#define FEP_SYSTEM_LATENCY_HISTORY_SIZE 100
+///The count of the systems (by name and discovery url) whose latencies learned for the adaptive timeouts are kept by the process (see fep3::System::setAdaptiveTimeouts)
+#define FEP_SYSTEM_LEARNED_LATENCIES_MAX_SYSTEMS 16
+///The fep::System default factor applied to the 99th percentile of the latencies of a participant (see fep3::System::setAdaptiveTimeouts)
+#define FEP_SYSTEM_ADAPTIVE_TIMEOUT_FACTOR 3.0
+///The fep::System default of the shortest adaptive timeout (see fep3::System::setAdaptiveTimeouts)
+#define FEP_SYSTEM_ADAPTIVE_TIMEOUT_FLOOR std::chrono::milliseconds(1000)
+///The fep::System default of the longest adaptive timeout (see fep3::System::setAdaptiveTimeouts)
+#define FEP_SYSTEM_ADAPTIVE_TIMEOUT_CEILING std::chrono::milliseconds(60000)
+///The count of the latest calls of a participant needed to derive its adaptive timeout (see fep3::System::setAdaptiveTimeouts)
+#define FEP_SYSTEM_ADAPTIVE_TIMEOUT_MIN_CALLS 10
+///The default maximum of the events recorded by fep3::startTracing
+#define FEP_SYSTEM_TRACE_MAX_EVENTS 100000
 ///The fep::discoverSystem default timeout
 #define FEP_SYSTEM_DISCOVER_TIMEOUT std::chrono::milliseconds(1000)
 ///The fep::ParticipantProxy default timeout for every fep::ParticipantProxy call that need to connect the participant
@@ -115,6 +141,45 @@ namespace fep3
         SystemAggregatedState _state;
     };
 
+    /**
+     * @brief Latencies of one transition (i.e. "start") observed at the participants of a system
+     * (see fep3::System::getTransitionLatencies).
+     * The percentiles are the nearest rank of the recorded durations of the calls.
+     */
+    struct TransitionLatencies
+    {
+        /**
+         * @brief Latencies of one participant
+         */
+        struct Participant
+        {
+            ///name of the participant
+            std::string _participant_name;
+            ///count of the recorded calls of the participant
+            size_t _count = 0;
+            ///median duration of the calls
+            std::chrono::microseconds _p50{ 0 };
+            ///90th percentile of the durations of the calls
+            std::chrono::microseconds _p90{ 0 };
+            ///99th percentile of the durations of the calls
+            std::chrono::microseconds _p99{ 0 };
+            ///longest duration of the calls
+            std::chrono::microseconds _max{ 0 };
+        };
+        ///count of the recorded calls of all participants
+        size_t _count = 0;
+        ///median duration of the calls of all participants
+        std::chrono::microseconds _p50{ 0 };
+        ///90th percentile of the durations of the calls of all participants
+        std::chrono::microseconds _p90{ 0 };
+        ///99th percentile of the durations of the calls of all participants
+        std::chrono::microseconds _p99{ 0 };
+        ///longest duration of the calls of all participants
+        std::chrono::microseconds _max{ 0 };
+        ///the slowest participants, ordered by their 90th percentile (the slowest first)
+        std::vector<Participant> _slowest;
+    };
+
     /**
      * @brief FEP System class is a collection of fep3::ParticipantProxy.
      * 
@@ -167,9 +232,13 @@ namespace fep3
         /**
          * @brief Copy Construct a new System object
          * 
+         * The copy shares the connections to the participants with @p other, so no request is sent
+         * (see ParticipantProxy::copyWithSharedConnection). The participants and their values (i.e. the priorities)
+         * are copied, adding, removing or changing them at one of the systems does not change the other.
+         * The participants log to the system which connected them, the logs are forwarded to the copies.
+         *
          * @param other the other system object to copy from
          * @remark we can not copy the registered event monitor!
-         *         This is also a very expensive operation, use move instead if possible!
          */
         System(const System& other);
         /**
@@ -181,9 +250,11 @@ namespace fep3
         /**
          * @brief Copy assignment
          *
+         * The participants of this system are replaced by the ones of @p other,
+         * they share the connections like a copy constructed system does.
+         *
          * @param other the other system object to copy from
          * @remark we can not copy the registered event monitor !
-         *         This is also a very expensive operation, use move instead if possible!
          * @return copied system
          */
         System& operator=(const System& other);
@@ -214,64 +285,394 @@ namespace fep3
         void setSystemState(System::AggregatedState state,
                             std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
 
+        /**
+         * @brief Brings every participant to the given state, also if the participants are in different states
+         * (i.e. after one participant crashed and was restarted).
+         * Each participant gets its own path to @p state, the paths are executed concurrently.
+         * Participants calling the same transition at the same time keep the order of their init or start priority.
+         * Participants without a statemachine are ignored.
+         *
+         * @param state the aggregated state to set
+         * @param timeout the timeout used for each round of statechanges
+         * @throw runtime_error if a participant is unreachable, declines a statechange
+         *        or the system is not homogeneously at @p state afterwards
+         */
+        void convergeSystemState(System::AggregatedState state,
+                                 std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+
         /**
          * @brief sends a load event to every participant
          * 
-         * @param timeout timeout for waiting on the response of every participant
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
          * @throw throws a logical_error if a participant declined the state change (i.e. it is in the wrong state)
+         * @throw runtime_error listing the participants which did not respond until the deadline
          */
         void load(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
         /**
          * @brief sends a unload event to every participant
          * 
-         * @param timeout timeout for waiting on the response of every participant
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
          * @throw throws a logical_error if a participant declined the state change (i.e. it is in the wrong state)
+         * @throw runtime_error listing the participants which did not respond until the deadline
          */
         void unload(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
         /**
          * @brief sends a initialize event to every participant
          * 
-         * @param timeout timeout for waiting on the response of every participant
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
          * @throw throws a logical_error if a participant declined the state change (i.e. it is in the wrong state)
+         * @throw runtime_error listing the participants which did not respond until the deadline
          */
         void initialize(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
         /**
          * @brief sends a deinitialize event to every participant
          * 
-         * @param timeout timeout for waiting on the response of every participant
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
          * @throw throws a logical_error if a participant declined the state change (i.e. it is in the wrong state)
+         * @throw runtime_error listing the participants which did not respond until the deadline
          */
         void deinitialize(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
         
         /**
          * @brief sends a start event to every participant
          * 
-         * @param timeout timeout for waiting on the response of every participant
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
          * @throw throws a logical_error if a participant declined the state change (i.e. it is in the wrong state)
+         * @throw runtime_error listing the participants which did not respond until the deadline
          */
         void start(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
         /**
          * @brief sends a pause event to every participant
          * 
-         * @param timeout timeout for waiting on the response of every participant
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
          * @throw throws a logical_error if a participant declined the state change (i.e. it is in the wrong state)
+         * @throw runtime_error listing the participants which did not respond until the deadline
          */
         void pause(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
         /**
          * @brief sends a stop event to every participant
          * 
-         * @param timeout timeout for waiting on the response of every participant
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
          * @throw throws a logical_error if a participant declined the state change (i.e. it is in the wrong state)
+         * @throw runtime_error listing the participants which did not respond until the deadline
          */
         void stop(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
         /**
          * @brief sends a shutdown event to every participant
+         * The participants are called concurrently, at most @ref getShutdownConcurrency at the same time.
          * 
-         * @param timeout timeout for waiting on the response of every participant
+         * @param timeout deadline for the responses of all participants
          * @throw throws a logical_error if a participant declined the state change (i.e. it is in the wrong state)
+         * @throw runtime_error listing the participants which did not respond until the deadline
          */
         void shutdown(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
 
+        /**
+         * @brief Sets the maximum of participants which are shut down at the same time (see @ref shutdown)
+         *
+         * @param max_concurrent_participants the maximum, 0 is treated as 1 (one participant after the other)
+         * @remark i.e. hosts running many participants may not cope with many shutdowns at the same time
+         */
+        void setShutdownConcurrency(size_t max_concurrent_participants);
+        /**
+         * @brief Gets the maximum of participants which are shut down at the same time
+         *
+         * @return the maximum, FEP_SYSTEM_SHUTDOWN_CONCURRENCY by default
+         */
+        size_t getShutdownConcurrency() const;
+        /**
+         * @brief Sets the maximum of participants of one host which are called at the same time within a transition.
+         * The participants are grouped by the host of their url (see @ref ParticipantProxy::getUrl),
+         * participants of other hosts are called without waiting for a busy host.
+         * Participants without a host in their url are not limited.
+         *
+         * @param max_concurrent_participants the maximum per host, 0 (default) for no limit
+         * @remark i.e. a host running many participants may be overloaded if all of them initialize at the same time
+         */
+        void setHostConcurrency(size_t max_concurrent_participants);
+        /**
+         * @brief Gets the maximum of participants of one host which are called at the same time (see @ref setHostConcurrency)
+         *
+         * @return the maximum per host, 0 for no limit
+         */
+        size_t getHostConcurrency() const;
+        /**
+         * @brief Enables or disables the reachability check before the transitions of the system
+         * (load, initialize, start, pause, stop, deinitialize, unload, setSystemState and convergeSystemState).
+         * Every participant is probed concurrently before any transition is sent.
+         * If at least one participant can not be reached within @p timeout, the call is aborted
+         * with the list of the unreachable participants and no participant changes its state.
+         *
+         * @param enable true to check the participants before each transition, false (default) for no check
+         * @param timeout deadline for the answers of all participants to the check
+         */
+        void setPreflightCheck(bool enable, std::chrono::milliseconds timeout = FEP_SYSTEM_DEFAULT_TIMEOUT);
+        /**
+         * @brief Checks if the reachability check before the transitions is enabled (see @ref setPreflightCheck)
+         *
+         * @return true if enabled, false if not
+         */
+        bool getPreflightCheck() const;
+        /**
+         * @brief Enables or disables idempotent transitions
+         * (load, initialize, start, pause, stop, deinitialize and unload).
+         * The states of all participants are requested concurrently before the transition,
+         * participants which are already in the target state of the transition are not called
+         * (i.e. initialize skips every participant which is already initialized).
+         * Participants in any other state are called and may decline the transition as before.
+         *
+         * @param enable true to skip the participants which are already in the target state, false (default) to call every participant
+         */
+        void setIdempotentTransitions(bool enable);
+        /**
+         * @brief Checks if idempotent transitions are enabled (see @ref setIdempotentTransitions)
+         *
+         * @return true if enabled, false if not
+         */
+        bool getIdempotentTransitions() const;
+        /**
+         * @brief Enables or disables the answers of @ref getSystemState from the state mirror of the system.
+         * The mirror holds the last known state of every participant. It is updated only by states the
+         * participants confirmed: the results of the transitions and state requests of the system and of a
+         * reconciliation which requests the states of all participants every @p reconciliation_interval.
+         * If enabled, @ref getSystemState does not call any participant as long as the state of every participant
+         * is known and the mirror is not older than @p max_staleness (see @ref getStateStaleness),
+         * otherwise it requests the participants.
+         * The first reconciliation is started immediately.
+         *
+         * @param enable true to answer from the mirror, false (default) to request the participants at each call
+         * @param reconciliation_interval the time between two reconciliations
+         * @param max_staleness the maximum age of the mirror answering @ref getSystemState
+         * @remark States changed by other systems are only noticed by the reconciliations and state requests,
+         *         see @ref getStateStaleness for the age of the mirror
+         */
+        void setStateMirror(bool enable,
+            std::chrono::milliseconds reconciliation_interval = FEP_SYSTEM_STATE_RECONCILIATION_INTERVAL,
+            std::chrono::milliseconds max_staleness = FEP_SYSTEM_STATE_MIRROR_MAX_STALENESS);
+        /**
+         * @brief Checks if @ref getSystemState answers from the state mirror (see @ref setStateMirror)
+         *
+         * @return true if enabled, false if not
+         */
+        bool getStateMirror() const;
+        /**
+         * @brief Gets the staleness bound of the state mirror (see @ref setStateMirror).
+         * This is the time since the last request of the states of all participants
+         * (a reconciliation or a @ref getSystemState which requested the participants),
+         * no state of the mirror is older.
+         *
+         * @return the staleness bound, std::chrono::milliseconds::max() if the states were never requested
+         */
+        std::chrono::milliseconds getStateStaleness() const;
+        /**
+         * @brief Enables or disables the health monitor of the system.
+         * The monitor probes every participant concurrently (by the participant info, which is the cheapest call)
+         * in the background and reports each participant which becomes unreachable and which is reachable again
+         * to the registered IEventMonitor (see @ref registerMonitoring) by IEventMonitor::onParticipantReachabilityChanged
+         * and by a log message (severity error or info).
+         * The interval starts at @p min_interval and is doubled after each check without a change
+         * up to @p max_interval, after a change it falls back to @p min_interval.
+         * So a dead participant is reported at the latest @p max_interval plus FEP_SYSTEM_DEFAULT_TIMEOUT
+         * after it died.
+         *
+         * @param enable true to start the monitor, false (default) to stop it
+         * @param min_interval the shortest time between two checks
+         * @param max_interval the longest time between two checks
+         */
+        void setHealthMonitor(bool enable,
+            std::chrono::milliseconds min_interval = FEP_SYSTEM_HEALTH_CHECK_MIN_INTERVAL,
+            std::chrono::milliseconds max_interval = FEP_SYSTEM_HEALTH_CHECK_MAX_INTERVAL);
+        /**
+         * @brief Checks if the health monitor is enabled (see @ref setHealthMonitor)
+         *
+         * @return true if enabled, false if not
+         */
+        bool getHealthMonitor() const;
+        /**
+         * @brief Sets the maximum age of the results of @ref getSystemState and @ref getTimingProperties
+         * which are reused for later calls.
+         * Concurrent identical calls (i.e. of several monitoring threads) always share one request
+         * of the participants and receive its result, independent of this setting.
+         * A reused system state is dropped as soon as the system learns a state change (see @ref setStateMirror),
+         * reused timing properties are dropped if participants are added or removed or the timing is configured.
+         *
+         * @param max_age the maximum age of a reused result, 0 (default) to reuse the results of running requests only
+         */
+        void setQueryCache(std::chrono::milliseconds max_age);
+        /**
+         * @brief Gets the maximum age of reused results (see @ref setQueryCache)
+         *
+         * @return the maximum age, 0 if results are not reused after their request finished
+         */
+        std::chrono::milliseconds getQueryCache() const;
+        /**
+         * @brief Gets the latencies of the calls of one transition at the participants.
+         * The duration of every transition call of every participant is recorded by the system
+         * (also of calls which failed or missed the deadline, as soon as they return),
+         * the latest FEP_SYSTEM_LATENCY_HISTORY_SIZE calls per participant and transition are kept.
+         * Use it to find the participants which define the latency of the system transitions.
+         *
+         * @param transition the transition, one of "load", "unload", "initialize", "deinitialize",
+         *                   "start", "pause", "stop" and "shutdown"
+         * @param slowest_count the maximum count of participants within TransitionLatencies::_slowest
+         * @return the latencies, all durations are 0 if no call of the transition was recorded
+         * @throw runtime_error if the transition is unknown
+         * @remark A participant without state machine answers every transition immediately.
+         */
+        TransitionLatencies getTransitionLatencies(const std::string& transition, size_t slowest_count = 5) const;
+        /**
+         * @brief Drops the recorded latencies of all transitions (see @ref getTransitionLatencies)
+         */
+        void clearTransitionLatencies();
+        /**
+         * @brief Enables or disables adaptive timeouts of the transitions.
+         * If enabled, each participant gets its own timeout for each transition:
+         * the 99th percentile of its latencies times @p factor, limited by @p floor and @p ceiling.
+         * A participant which does not answer within its own timeout is reported as missed deadline
+         * (like by the timeout of the transition), even if the timeout of the transition is not reached yet.
+         * The transition waits at least for the longest own timeout of the participants called at the same time
+         * (taken from the reserve of the following priority levels), but never longer than its own timeout.
+         * Participants with less than FEP_SYSTEM_ADAPTIVE_TIMEOUT_MIN_CALLS recorded calls of a transition
+         * are limited by the timeout of the transition only.
+         * The latencies are learned by every system of the process with the same name and discovery url,
+         * so a new fep3::System instance starts with the latencies its participants had in the previous ones.
+         * They are kept if the transition latencies are cleared. The process keeps the latencies of the
+         * FEP_SYSTEM_LEARNED_LATENCIES_MAX_SYSTEMS systems created most recently, plus the ones still in use.
+         *
+         * @param enable true to use adaptive timeouts, false (default) to use the timeouts of the transitions only
+         * @param factor the safety factor applied to the 99th percentile, a factor below 1.0 is treated as 1.0
+         * @param floor the shortest adaptive timeout
+         * @param ceiling the longest adaptive timeout, a ceiling below @p floor is treated as @p floor
+         * @remark The latencies are learned independent of this setting,
+         *         see @ref getTransitionLatencies for the latencies of this system
+         */
+        void setAdaptiveTimeouts(bool enable,
+            double factor = FEP_SYSTEM_ADAPTIVE_TIMEOUT_FACTOR,
+            std::chrono::milliseconds floor = FEP_SYSTEM_ADAPTIVE_TIMEOUT_FLOOR,
+            std::chrono::milliseconds ceiling = FEP_SYSTEM_ADAPTIVE_TIMEOUT_CEILING);
+        /**
+         * @brief Checks if adaptive timeouts are enabled (see @ref setAdaptiveTimeouts)
+         *
+         * @return true if enabled, false if not
+         */
+        bool getAdaptiveTimeouts() const;
+        /**
+         * @brief Gets the adaptive timeout of one participant for one transition (see @ref setAdaptiveTimeouts)
+         *
+         * @param participant_name name of the participant
+         * @param transition the transition (see @ref getTransitionLatencies)
+         * @return the timeout, 0 if less than FEP_SYSTEM_ADAPTIVE_TIMEOUT_MIN_CALLS calls are recorded
+         *         (it is derived even if adaptive timeouts are disabled, so it may be checked before enabling them)
+         * @throw runtime_error if the transition is unknown
+         */
+        std::chrono::milliseconds getAdaptiveTimeout(const std::string& participant_name,
+            const std::string& transition) const;
+        /**
+         * @brief Enables or disables the lazy connection of the participants added afterwards.
+         * A lazily connected participant proxy is created without any request to the participant,
+         * each RPC component of the participant (i.e. the state machine) is connected at its first use
+         * and the system registers its logging sink at the participant as soon as the first component is connected.
+         * So adding participants costs no requests and unreachable participants cost nothing until they are used.
+         * Use it for tools which open a system to query some participants only.
+         *
+         * @param enable true to connect the participants at their first use, false (default) to connect them when added
+         * @remark The participants already added keep their connection mode.
+         */
+        void setLazyConnection(bool enable);
+        /**
+         * @brief Checks if participants are connected at their first use (see @ref setLazyConnection)
+         *
+         * @return true if enabled, false if not
+         */
+        bool getLazyConnection() const;
+
+        /**
+         * @brief Sets the system state asynchronously (see @ref setSystemState)
+         *
+         * @param state the aggregated state to set
+         * @param timeout the timeout used for each statechange
+         * @return handle of the running operation
+         * @throw runtime_error if @p state is not valid as system state
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation setSystemStateAsync(System::AggregatedState state,
+                                            std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief Brings every participant to the given state asynchronously (see @ref convergeSystemState)
+         *
+         * @param state the aggregated state to set
+         * @param timeout the timeout used for each round of statechanges
+         * @return handle of the running operation, it reports the progress of every participant
+         * @throw runtime_error if @p state is not valid as system state
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation convergeSystemStateAsync(System::AggregatedState state,
+                                                 std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief sends a load event to every participant asynchronously (see @ref load)
+         *
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
+         * @return handle of the running operation, it reports the progress of every participant
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation loadAsync(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief sends a unload event to every participant asynchronously (see @ref unload)
+         *
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
+         * @return handle of the running operation, it reports the progress of every participant
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation unloadAsync(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief sends a initialize event to every participant asynchronously (see @ref initialize)
+         *
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
+         * @return handle of the running operation, it reports the progress of every participant
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation initializeAsync(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief sends a deinitialize event to every participant asynchronously (see @ref deinitialize)
+         *
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
+         * @return handle of the running operation, it reports the progress of every participant
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation deinitializeAsync(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief sends a start event to every participant asynchronously (see @ref start)
+         *
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
+         * @return handle of the running operation, it reports the progress of every participant
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation startAsync(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief sends a pause event to every participant asynchronously (see @ref pause)
+         *
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
+         * @return handle of the running operation, it reports the progress of every participant
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation pauseAsync(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief sends a stop event to every participant asynchronously (see @ref stop)
+         *
+         * @param timeout deadline for the responses of all participants, the budget is split across the priority levels
+         * @return handle of the running operation, it reports the progress of every participant
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation stopAsync(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief sends a shutdown event to every participant asynchronously (see @ref shutdown)
+         *
+         * @param timeout deadline for the responses of all participants
+         * @return handle of the running operation, it reports the progress of every participant
+         * @remark the operation is cancelled if the system is destroyed
+         */
+        SystemOperation shutdownAsync(std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+
         /**
         * @c getParticipant returns the participant object
         * @param participant_name name of the participant to retrieve
@@ -298,15 +699,19 @@ namespace fep3
                  const std::string& participant_url = std::string());
         /**
         * @c adds the list of participants to the system
+        * The proxies of the participants are created concurrently and the participants are added all or none.
         * @param[in]  participants         list of participant names
-        *
+        * @throw runtime_error if a participant with one of the names already exists
+        *        or the proxy of one of the participants can not be created
         */
         void add(const std::vector<std::string>& participants);
 
         /**
         * @c adds the list of participants to the system
+        * The proxies of the participants are created concurrently and the participants are added all or none.
         * @param[in]  participants         map of participant names and url pairs
-        *
+        * @throw runtime_error if a participant with one of the names already exists
+        *        or the proxy of one of the participants can not be created
         */
         void add(const std::multimap<std::string, std::string>& participants);
         /**
@@ -442,12 +847,43 @@ namespace fep3
         * @note This method is _not_ thread safe. Do not call concurrently inside the same participant!
         *
         * @param[in]  timeout      (ms) time how long this method waits maximally for other
-        *                           participants to respond
+        *                           participants to respond, participants which did not respond
+        *                           in time are considered as unreachable
         *
         * @return State
         * @remark On Failure a IEventMonitor::onLog will be send with a detailed description
         */
         State getSystemState(std::chrono::milliseconds timeout = FEP_SYSTEM_DEFAULT_TIMEOUT) const;
+        /**
+         * @brief Blocks until the system state is homogeneous @p state (see @ref getSystemState)
+         * or the @p timeout is reached.
+         * The waiting thread is woken up by every state change the system learns
+         * (its own transitions and state requests and the reconciliations of the state mirror,
+         * see @ref setStateMirror). In addition the participants are
+         * requested immediately and then in an exponentially growing interval (50 ms up to 1 s),
+         * so states changed silently are noticed as well.
+         * The participants do not push their state changes, so a change not caused by this process
+         * (i.e. by another system instance or the participant itself) is noticed by these requests only,
+         * up to 1 s after it happened.
+         *
+         * @param state the aggregated state to wait for
+         * @param timeout time to wait
+         * @return true if the state is reached, false if the timeout was reached before
+         */
+        bool waitForSystemState(AggregatedState state, std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
+        /**
+         * @brief Blocks until the participant @p participant_name is in @p state or the @p timeout is reached
+         * (see @ref waitForSystemState). Only this participant is requested while waiting.
+         *
+         * @param participant_name name of the participant
+         * @param state the state to wait for
+         * @param timeout time to wait
+         * @return true if the state is reached, false if the timeout was reached before
+         * @throw runtime_error if the participant is not part of the system
+         */
+        bool waitForParticipantState(const std::string& participant_name,
+            AggregatedState state,
+            std::chrono::milliseconds timeout = FEP_SYSTEM_TRANSITION_TIMEOUT) const;
 
         /**
          * @brief Get the System Name object
@@ -465,6 +901,8 @@ namespace fep3
 
         /**
         * Register monitoring listener for state and name changed notifications of the whole system
+        * The listener also receives the progress of the transitions asynchronously
+        * (see IEventMonitor::onTransitionStarted).
         *
         * @param [in] event_listener The listener
         * @retval true/false        Everything went fine/Something went wrong.
@@ -565,4 +1003,37 @@ namespace fep3
     std::vector<System> FEP3_SYSTEM_EXPORT discoverAllSystemsByURL(std::string discover_url,
         std::chrono::milliseconds timeout = FEP_SYSTEM_DISCOVER_TIMEOUT);
 
+    /**
+     * startTracing starts to record the begin and end of the system operations of this process
+     * (transitions, state requests, property fan-outs and discoveries of every fep3::System)
+     * and of every call of a participant issued within them.
+     * The events recorded so far are dropped.
+     *
+     * @param[in]  max_event_count   the events after the first @p max_event_count are dropped (and counted)
+     * @see getTrace
+     */
+    void FEP3_SYSTEM_EXPORT startTracing(size_t max_event_count = FEP_SYSTEM_TRACE_MAX_EVENTS);
+
+    /**
+     * stopTracing stops the recording, the recorded events are kept until the next @ref startTracing.
+     */
+    void FEP3_SYSTEM_EXPORT stopTracing();
+
+    /**
+     * getTrace gets the recorded events as Chrome trace JSON (loadable by chrome://tracing or Perfetto).
+     * Every system is one process of the trace, its operations and each of its participants are threads of it.
+     * Overlapping calls of one participant (i.e. a state request within a transition) are shown in additional threads.
+     *
+     * @return the trace, also if tracing is running
+     */
+    std::string FEP3_SYSTEM_EXPORT getTrace();
+
+    /**
+     * writeTrace writes the recorded events to @p file_path (see @ref getTrace).
+     *
+     * @param[in]  file_path   path of the JSON file, an existing file is overwritten
+     * @throw runtime_error if the file can not be written
+     */
+    void FEP3_SYSTEM_EXPORT writeTrace(const std::string& file_path);
+
 }
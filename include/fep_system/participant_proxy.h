@@ -30,6 +30,7 @@ You may add additional accurate notices of copyright ownership.
 
 #include <string>
 #include <chrono>
+#include <vector>
 
 namespace fep3
 {
@@ -64,13 +65,18 @@ public:
      * @param system_url url of the system
      * @param logger logger to log values to.
      * @param default_timeout default timeout for each rpc request
+     * @param lazy_connection true to construct the proxy without any request to the participant,
+     *                        each RPC component is connected at its first use (an unreachable participant
+     *                        is not noticed until then), false to connect the participant info,
+     *                        state machine and logging sink immediately
      */
     ParticipantProxy(const std::string& participant_name,
         const std::string& participant_url,
         const std::string& system_name,
         const std::string& system_url,
         ISystemLogger& logger,
-        std::chrono::milliseconds default_timeout);
+        std::chrono::milliseconds default_timeout,
+        bool lazy_connection = false);
     /**
      * @brief Construct a new Participant Proxy object
      *
@@ -116,6 +122,17 @@ public:
      */
     void copyValuesTo(ParticipantProxy& other) const;
 
+    /**
+     * Creates a proxy of the same participant which shares the connection of this proxy
+     * (the RPC components and the logging sink registered at the participant), so no request is sent.
+     * The values (priorities, dependencies and additional info) are copied, changing them
+     * at one of the proxies does not change them at the other.
+     *
+     * @return the new proxy, an invalid proxy if this proxy is invalid
+     * @remark the logger this proxy was created with must live as long as the new proxy
+     */
+    ParticipantProxy copyWithSharedConnection() const;
+
     /**
     * set priority that the participant should use when the system is triggered
     * into state FS_READY.
@@ -123,6 +140,8 @@ public:
     * and will be evaluated separately
     * The lower the priority the later the participant will be triggered.
     * Negative values are allowed
+    * Participants with the same priority are triggered at the same time, in the order they were added to the system
+    * (in the reverse order for deinitialize and unload).
     *
     * @param [in] priority    priority, the participant should use for loading, initialization
     * @see @ref fep3::System::load, fep3::System::initialize
@@ -142,6 +161,8 @@ public:
      * and will be evaluated separately
      * The lower the priority the later the participant will be triggered.
      * Negative values are allowed
+     * Participants with the same priority are triggered at the same time, in the order they were added to the system
+     * (in the reverse order for stop).
      *
      * @param [in] priority    priority, the participant should use for initialization
      * @see @ref fep3::System::start, @ref fep3::System::pause
@@ -155,6 +176,45 @@ public:
      */
     int32_t getStartPriority() const;
 
+    /**
+     * set the participants which have to be triggered before this participant when the system
+     * is loaded or initialized (and after this participant when it is deinitialized, unloaded or stopped).
+     * The participant is triggered as soon as these participants answered, there is no barrier between priority levels.
+     * /note if at least one participant of the system has init dependencies, the init priorities are not used.
+     * Participants which are not part of the system are ignored.
+     *
+     * @param [in] participant_names names of the participants this participant depends on
+     * @see @ref fep3::System::load, fep3::System::initialize
+     * @remark a cycle of dependencies lets the transition fail
+     */
+    void setInitDependencies(const std::vector<std::string>& participant_names);
+    /**
+     * @brief Get the Init Dependencies
+     *
+     * @return the names of the participants this participant depends on
+     * @see @ref setInitDependencies
+     */
+    std::vector<std::string> getInitDependencies() const;
+    /**
+     * set the participants which have to be triggered before this participant when the system
+     * is started or paused.
+     * The participant is triggered as soon as these participants answered, there is no barrier between priority levels.
+     * /note if at least one participant of the system has start dependencies, the start priorities are not used.
+     * Participants which are not part of the system are ignored.
+     *
+     * @param [in] participant_names names of the participants this participant depends on
+     * @see @ref fep3::System::start, @ref fep3::System::pause
+     * @remark a cycle of dependencies lets the transition fail
+     */
+    void setStartDependencies(const std::vector<std::string>& participant_names);
+    /**
+     * @brief Get the Start Dependencies
+     *
+     * @return the names of the participants this participant depends on
+     * @see @ref setStartDependencies
+     */
+    std::vector<std::string> getStartDependencies() const;
+
     /**
      * @brief Get the Name of the participant
      *
@@ -0,0 +1,170 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+Copyright @ 2020 Audi AG. All rights reserved.
+
+This Source Code Form is subject to the terms of the Mozilla
+Public License, v. 2.0. If a copy of the MPL was not distributed
+with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+*/
+#pragma once
+
+#include "fep_system/fep_system_types.h"
+
+#include <string>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace fep3
+{
+/**
+ * @brief Progress of one participant within a fep3::SystemOperation
+ *
+ */
+struct ParticipantProgress
+{
+    /**
+     * @brief Status of the call to the participant
+     *
+     */
+    enum class Status
+    {
+        ///the participant was not called yet (i.e. it belongs to a lower priority level)
+        pending,
+        ///the participant is called at the moment
+        running,
+        ///the participant answered successfully
+        done,
+        ///the participant declined the call or can not be connected
+        failed,
+        ///the participant did not answer until the deadline
+        timed_out,
+        ///the operation was cancelled before the participant answered
+        cancelled
+    };
+    ///name of the participant
+    std::string _participant_name;
+    ///status of the last call to the participant
+    Status _status;
+    ///error message if the status is @c failed
+    std::string _error_message;
+};
+
+/**
+ * @brief Handle of an asynchronous operation of a fep3::System (i.e. fep3::System::startAsync).
+ * Copies of the handle refer to the same operation.
+ *
+ * The operation is driven by the worker threads of the system, no thread of the caller is blocked.
+ * It is finished if every participant has answered, the deadline (timeout) is reached,
+ * an error occurred or it was cancelled.
+ */
+class FEP3_SYSTEM_EXPORT SystemOperation final
+{
+public:
+    /**
+     * @brief Construct an invalid operation handle
+     *
+     */
+    SystemOperation() = default;
+    /**
+     * @brief DTOR
+     * The operation is not cancelled if the last handle is destroyed.
+     */
+    ~SystemOperation();
+    /**
+     * @brief Copy construct a handle to the same operation
+     *
+     * @param other the other handle
+     */
+    SystemOperation(const SystemOperation& other);
+    /**
+     * @brief Copy assignment
+     *
+     * @param other the other handle
+     * @return this handle
+     */
+    SystemOperation& operator=(const SystemOperation& other);
+    /**
+     * @brief Move construct
+     *
+     * @param other the other handle
+     */
+    SystemOperation(SystemOperation&& other);
+    /**
+     * @brief Move assignment
+     *
+     * @param other the other handle
+     * @return this handle
+     */
+    SystemOperation& operator=(SystemOperation&& other);
+
+    /**
+     * @brief Checks if the handle refers to an operation
+     *
+     * @return true if valid, false if not
+     */
+    operator bool() const
+    {
+        return static_cast<bool>(_impl);
+    }
+
+    /**
+     * @brief Checks if the operation is finished (successfully, with an error or cancelled)
+     *
+     * @return true if finished, false if not
+     */
+    bool isDone() const;
+    /**
+     * @brief Blocks until the operation is finished
+     *
+     */
+    void wait() const;
+    /**
+     * @brief Blocks until the operation is finished or the @p timeout is reached
+     *
+     * @param timeout time to wait
+     * @return true if finished, false if the timeout was reached before
+     */
+    bool waitFor(std::chrono::milliseconds timeout) const;
+    /**
+     * @brief Blocks until the operation is finished and rethrows its error
+     *
+     * @throw runtime_error with the same content as the synchronous call of the fep3::System would throw
+     */
+    void get() const;
+    /**
+     * @brief Cancels the operation.
+     * Participants which were not called yet are not called anymore,
+     * calls which are still running are abandoned.
+     * The operation is finished with an error.
+     *
+     */
+    void cancel() const;
+    /**
+     * @brief Gets the progress of every participant of the operation
+     *
+     * @return the progress in order of the participants within the system
+     */
+    std::vector<ParticipantProgress> getParticipantProgress() const;
+
+public:
+    /// @cond no_documentation
+    struct Implementation;
+    explicit SystemOperation(const std::shared_ptr<Implementation>& impl);
+    /// @endcond no_documentation
+
+private:
+    std::shared_ptr<Implementation> _impl;
+};
+
+}
@@ -23,7 +23,21 @@
 #include <service_bus_factory.h>
 #include "a_util/process.h"
 #include "system_logger.h"
+#include "private_system_operation.hpp"
+#include "system_state_mirror.h"
+#include "single_flight.h"
+#include "state_machine_clients.h"
+#include "latency_history.h"
+#include "participant_registry.h"
+#include "priority_index.h"
+#include "system_tracer.h"
+#include "transition_progress.h"
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <list>
 #include <map>
+#include <set>
 #include <mutex>
 #include <thread>
 #include <algorithm>
@@ -47,8 +61,50 @@ namespace
 
 namespace fep3
 {
-    static constexpr int min_timeout = 500;
-    static constexpr int timeout_divident = 10;
+    //maximum count of participants which are called concurrently by one system,
+    //calls abandoned after their deadline are not counted (see WorkerPool::abandon)
+    static constexpr size_t max_worker_count = 32;
+    //bounds of the interval (ms) of the state requests while waiting for a state
+    static constexpr int min_state_request_interval = 50;
+    static constexpr int max_state_request_interval = 1000;
+    //shortest timeout (ms) of the state requests while waiting for a state, with less time left the participants are not requested
+    static constexpr int min_state_request_timeout = 50;
+
+    /**
+     * Gets the latencies learned by all systems of the process with the name @p system_name
+     * and the discovery url @p system_discovery_url.
+     * They outlive the fep3::System instances, so the adaptive timeouts of a new instance are known immediately.
+     * The latencies of the FEP_SYSTEM_LEARNED_LATENCIES_MAX_SYSTEMS systems created most recently are kept,
+     * the ones of the others are dropped as soon as no instance uses them anymore.
+     */
+    static std::shared_ptr<LatencyHistory> getLearnedLatencies(const std::string& system_name,
+        const std::string& system_discovery_url)
+    {
+        using Key = std::pair<std::string, std::string>;
+        static std::mutex sync_learned_latencies;
+        //the systems created most recently first
+        static std::list<std::pair<Key, std::shared_ptr<LatencyHistory>>> learned_latencies;
+        std::lock_guard<std::mutex> lock(sync_learned_latencies);
+        const Key key(system_name, system_discovery_url);
+        auto found = std::find_if(learned_latencies.begin(), learned_latencies.end(),
+            [&key](const std::pair<Key, std::shared_ptr<LatencyHistory>>& latencies)
+            {
+                return latencies.first == key;
+            });
+        if (found != learned_latencies.end())
+        {
+            learned_latencies.splice(learned_latencies.begin(), learned_latencies, found);
+        }
+        else
+        {
+            learned_latencies.emplace_front(key, std::make_shared<LatencyHistory>(FEP_SYSTEM_LATENCY_HISTORY_SIZE));
+            if (learned_latencies.size() > FEP_SYSTEM_LEARNED_LATENCIES_MAX_SYSTEMS)
+            {
+                learned_latencies.pop_back();
+            }
+        }
+        return learned_latencies.front().second;
+    }
 
     struct System::Implementation
     {
@@ -60,7 +116,9 @@ namespace fep3
             //we need to use _use_default_url here => only this is to use the default
             //if we do not do this and use empty, discovery is switched off
             _service_bus_connection = ServiceBusFactory::get().createOrGetServiceBusConnection(system_name, _system_discovery_url);
+            _learned_latencies = getLearnedLatencies(_system_name, _system_discovery_url);
             _logger->initRPCService(_system_name);
+            filterForwardedLogs();
         }
 
         explicit Implementation(const std::string& system_name,
@@ -70,7 +128,9 @@ namespace fep3
         {
             //if system_discovery_url is empty ... it will be switched off
             _service_bus_connection = ServiceBusFactory::get().createOrGetServiceBusConnection(system_name, system_discovery_url);
+            _learned_latencies = getLearnedLatencies(_system_name, _system_discovery_url);
             _logger->initRPCService(_system_name);
+            filterForwardedLogs();
         }
 
         Implementation(const Implementation& other) = delete;
@@ -81,21 +141,45 @@ namespace fep3
         {
             _system_name = std::move(other._system_name);
             _system_discovery_url = std::move(other._system_discovery_url);
+            _connection_loggers = std::move(other._connection_loggers);
             _participants = std::move(other._participants);
+            _priority_index.remove();
             _logger = std::move(other._logger);
             _service_bus_connection = other._service_bus_connection;
+            _learned_latencies = other._learned_latencies;
             return *this;
         }
 
         ~Implementation()
         {
+            {
+                //waits for a running timer, the later ones do not use the system
+                std::lock_guard<std::mutex> lock(_lifetime->_sync);
+                _lifetime->_shut_down = true;
+            }
+            stopReconciliation();
+            stopHealthMonitor();
+            //the logger lives as long as a copy of the system shares the connections of its participants
+            _logger->setForwardFilter({});
+            _logger->releaseMonitor();
+            cancelOperations();
             clear();
         }
 
+        void filterForwardedLogs()
+        {
+            auto state_mirror = _state_mirror;
+            //logs forwarded from the loggers of shared connections (see addSharedParticipants)
+            _logger->setForwardFilter([state_mirror](const std::string& participant_name)
+            {
+                return state_mirror->hasParticipant(participant_name);
+            });
+        }
+
         std::vector<std::string> mapToStringVec() const
         { 
             std::vector<std::string> participants;
-            for (const auto& p : _participants)
+            for (const auto& p : _participants.getOrdered())
             {
                 participants.push_back(p.getName());
             }
@@ -104,487 +188,1918 @@ namespace fep3
 
         std::vector<ParticipantProxy> mapToProxyVec() const
         {
-            return _participants;
+            return _participants.getOrdered();
         }
 
-        std::map<int32_t, std::vector<ParticipantProxy>> getParticipantsSortedbyStartPrio()
+        static std::vector<size_t> getIndexes(const std::vector<ParticipantProxy>& participants)
         {
-            std::map<int32_t, std::vector<ParticipantProxy>> participants_sorted_by_prio;
-            std::vector<ParticipantProxy> participants;
-            for (const auto& part : _participants)
+            std::vector<size_t> indexes;
+            for (size_t index = 0; index < participants.size(); ++index)
             {
-                auto prio = part.getStartPriority();
-                participants_sorted_by_prio[prio].push_back(part);
+                indexes.push_back(index);
             }
-            return std::move(participants_sorted_by_prio);
+            return indexes;
         }
 
-        std::map<int32_t, std::vector<ParticipantProxy>> getParticipantsSortedbyInitPrio()
+        /**
+         * Gets the indexes of @p participants in levels of their init or start priority.
+         * For @p reverse_prio the highest priority comes first and the participants of one level keep their order,
+         * otherwise the lowest priority comes first and the order within one level is reversed.
+         */
+        static std::vector<std::vector<size_t>> getPriorityLevels(const std::vector<ParticipantProxy>& participants,
+            bool init_false_start_true,
+            bool reverse_prio)
         {
-            std::map<int32_t, std::vector<ParticipantProxy>> participants_sorted_by_prio;
-            std::vector<ParticipantProxy> participants;
-            for (const auto& part : _participants)
-            {
-                auto prio = part.getInitPriority();
-                participants_sorted_by_prio[prio].push_back(part);
-            }
-            return std::move(participants_sorted_by_prio);
+            return getPriorityLevels(participants, getIndexes(participants), init_false_start_true, reverse_prio);
         }
 
-        void for_each_ordered_reverse(std::map<int32_t, std::vector<ParticipantProxy>>& sorted_parts,
-            const std::function<void(ParticipantProxy&)>& call)
+        /**
+         * Gets the @p indexes of @p participants in levels of their init or start priority
+         * (see getPriorityLevels above).
+         */
+        static std::vector<std::vector<size_t>> getPriorityLevels(const std::vector<ParticipantProxy>& participants,
+            const std::vector<size_t>& indexes,
+            bool init_false_start_true,
+            bool reverse_prio)
         {
-            //reverse order of prio
-            for (auto current_prio = sorted_parts.rbegin();
-                 current_prio != sorted_parts.rend();
-                 ++current_prio)
+            std::map<int32_t, std::vector<size_t>> participants_sorted_by_prio;
+            for (auto index : indexes)
+            {
+                auto prio = init_false_start_true ? participants[index].getStartPriority()
+                                                  : participants[index].getInitPriority();
+                participants_sorted_by_prio[prio].push_back(index);
+            }
+            std::vector<std::vector<size_t>> levels;
+            if (reverse_prio)
             {
-                //normal order of parts having the same prio(unfortunatelly this is by name at the moment)
-                auto& current_prio_parts = current_prio->second;
-                for (auto& part_to_call : current_prio_parts)
+                //reverse order of prio, normal order of parts having the same prio
+                for (auto current_prio = participants_sorted_by_prio.rbegin();
+                     current_prio != participants_sorted_by_prio.rend();
+                     ++current_prio)
                 {
-                    call(part_to_call);
+                    levels.push_back(std::move(current_prio->second));
                 }
             }
-        }
-
-        void for_each_ordered(std::map<int32_t, std::vector<ParticipantProxy>>& sorted_parts,
-            const std::function<void(ParticipantProxy&)>& call)
-        {
-            //normal order of prio
-            for (auto current_prio = sorted_parts.begin();
-                current_prio != sorted_parts.end();
-                ++current_prio)
+            else
             {
-                //reverse order of parts having the same prio (unfortunatelly this is by name at the moment)
-                auto& current_prio_parts = current_prio->second;
-                for (auto part_to_call = current_prio_parts.rbegin();
-                     part_to_call != current_prio_parts.rend();
-                     ++part_to_call)
+                //normal order of prio, reverse order of parts having the same prio
+                for (auto current_prio = participants_sorted_by_prio.begin();
+                     current_prio != participants_sorted_by_prio.end();
+                     ++current_prio)
                 {
-                    call(*part_to_call);
+                    auto& current_prio_parts = current_prio->second;
+                    std::reverse(current_prio_parts.begin(), current_prio_parts.end());
+                    levels.push_back(std::move(current_prio_parts));
                 }
             }
+            return levels;
         }
 
-        void reverse_state_change(std::chrono::milliseconds,
-            const std::string& logging_info,
-            bool init_false_start_true,
-            const std::function<void(RPCComponent<rpc::IRPCParticipantStateMachine>&)>& call_at_state)
+        static bool hasDependencies(const std::vector<ParticipantProxy>& participants, bool init_false_start_true)
         {
-            if (_participants.empty())
-            {
-                _logger->log(logging::Severity::warning, "",
-                    _system_name, "No participants within the current system");
-                return;
-            }
-            std::string error_message;
-            std::map<int32_t,std::vector<ParticipantProxy>> sorted_part;
-            if (!init_false_start_true)
+            return std::any_of(participants.begin(), participants.end(), [&](const ParticipantProxy& participant)
             {
-                sorted_part = getParticipantsSortedbyInitPrio();
-            }
-            else
+                return !(init_false_start_true ? participant.getStartDependencies()
+                                               : participant.getInitDependencies()).empty();
+            });
+        }
+
+        /**
+         * Adds the predecessors of the @p indexes of @p participants given by their init or start dependencies.
+         * For @p reverse_prio (load, initialize, start and pause) a participant follows the participants it depends on,
+         * otherwise (unload, deinitialize and stop) it precedes them.
+         * Dependencies to participants which are not within @p indexes are ignored.
+         * @return true if at least one dependency was added
+         */
+        static bool addDependencies(const std::vector<ParticipantProxy>& participants,
+            const std::vector<size_t>& indexes,
+            bool init_false_start_true,
+            bool reverse_prio,
+            std::vector<std::vector<size_t>>& predecessors)
+        {
+            std::map<std::string, size_t> index_by_name;
+            for (auto index : indexes)
             {
-                sorted_part = getParticipantsSortedbyStartPrio();
+                index_by_name[participants[index].getName()] = index;
             }
-            for_each_ordered_reverse(sorted_part,
-                [&](ParticipantProxy& proxy)
+            bool added = false;
+            for (auto index : indexes)
             {
-                auto state_machine = proxy.getRPCComponentProxyByIID<rpc::IRPCParticipantStateMachine>();
-                if (state_machine)
+                const auto dependencies = init_false_start_true ? participants[index].getStartDependencies()
+                                                                : participants[index].getInitDependencies();
+                for (const auto& dependency : dependencies)
                 {
-                    try
+                    auto dependency_index = index_by_name.find(dependency);
+                    if (dependency_index == index_by_name.end() || dependency_index->second == index)
+                    {
+                        continue;
+                    }
+                    if (reverse_prio)
                     {
-                        call_at_state(state_machine);
+                        predecessors[index].push_back(dependency_index->second);
                     }
-                    catch (const std::exception& ex)
+                    else
                     {
-                        error_message += std::string(" ") + ex.what();
+                        predecessors[dependency_index->second].push_back(index);
                     }
+                    added = true;
                 }
-            });
-            if (!error_message.empty())
-            {
-                FEP3_SYSTEM_LOG_AND_THROW(
-                    _logger,
-                    logging::Severity::fatal,
-                    "",
-                    _system_name,
-                    error_message);
             }
+            return added;
+        }
 
-            _logger->log(logging::Severity::info, "",
-                _system_name, "system " + logging_info + " successfully");
+        /**
+         * Lets @p phase call the @p indexes of @p participants in the order of @p predecessors
+         * instead of priority levels.
+         * @throw runtime_error if the dependencies are cyclic
+         */
+        static void setDependencyOrder(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            OperationPhase& phase,
+            const std::vector<ParticipantProxy>& participants,
+            const std::vector<size_t>& indexes,
+            const std::vector<std::vector<size_t>>& predecessors)
+        {
+            //topological order, used for the order of the error messages
+            std::vector<size_t> sorted;
+            std::vector<size_t> open = indexes;
+            while (!open.empty())
+            {
+                const std::set<size_t> open_set(open.begin(), open.end());
+                auto ready = std::stable_partition(open.begin(), open.end(), [&](size_t index)
+                {
+                    return std::any_of(predecessors[index].begin(), predecessors[index].end(), [&](size_t predecessor)
+                    {
+                        return open_set.count(predecessor) != 0;
+                    });
+                });
+                if (ready == open.end())
+                {
+                    std::vector<std::string> cyclic_participants;
+                    for (auto index : open)
+                    {
+                        cyclic_participants.push_back(participants[index].getName());
+                    }
+                    FEP3_SYSTEM_LOG_AND_THROW(logger,
+                        logging::Severity::error,
+                        "",
+                        system_name,
+                        "Cyclic dependencies, the participants " + join(cyclic_participants, ", ")
+                        + " of system " + system_name + " can not be ordered");
+                }
+                sorted.insert(sorted.end(), ready, open.end());
+                open.erase(ready, open.end());
+            }
+            phase._levels = { sorted };
+            phase._predecessors = predecessors;
         }
 
-        void normal_state_change(std::chrono::milliseconds,
-            const std::string& logging_info,
-            bool init_false_start_true,
-            const std::function<void(RPCComponent<rpc::IRPCParticipantStateMachine>&)>& call_at_state)
+        static std::string getMissedDeadlineMessage(std::chrono::milliseconds timeout,
+            const std::vector<ParticipantProxy>& participants,
+            const OperationPhase::Result& result)
         {
-            if (_participants.empty())
+            std::vector<std::string> missed_deadline;
+            for (const auto missed_participant : result._missed_deadline)
             {
-                _logger->log(logging::Severity::warning, "",
-                    _system_name, "No participants within the current system");
-                return;
+                if (std::find(result._missed_call_timeout.begin(), result._missed_call_timeout.end(), missed_participant)
+                    == result._missed_call_timeout.end())
+                {
+                    missed_deadline.push_back(participants[missed_participant].getName());
+                }
             }
-            std::string error_message;
-            std::map<int32_t, std::vector<ParticipantProxy>> sorted_part;
-            if (!init_false_start_true)
+            std::vector<std::string> missed_call_timeout;
+            for (const auto missed_participant : result._missed_call_timeout)
             {
-                sorted_part = getParticipantsSortedbyInitPrio();
+                missed_call_timeout.push_back(participants[missed_participant].getName());
             }
-            else
+            std::string message;
+            if (!missed_deadline.empty())
             {
-                sorted_part = getParticipantsSortedbyStartPrio();
+                message += " Timeout of " + std::to_string(timeout.count()) + " ms exceeded, no answer from participants: "
+                    + join(missed_deadline, ", ");
             }
-            for_each_ordered(sorted_part,
-                [&](ParticipantProxy& proxy)
+            if (!missed_call_timeout.empty())
             {
-                auto state_machine = proxy.getRPCComponentProxyByIID<rpc::IRPCParticipantStateMachine>();
-                if (state_machine)
-                {
-                    try
+                message += " Adaptive timeout exceeded, no answer from participants: "
+                    + join(missed_call_timeout, ", ");
+            }
+            return message;
+        }
+
+        enum class Transition
+        {
+            load,
+            unload,
+            initialize,
+            deinitialize,
+            start,
+            pause,
+            stop,
+            shutdown
+        };
+
+        ///how a transition is called at the participants
+        struct TransitionInfo
+        {
+            ///name of the transition within the latency history
+            std::string _name;
+            std::string _logging_info;
+            bool _init_false_start_true = false;
+            bool _reverse_prio = false;
+            std::function<void(RPCComponent<rpc::IRPCParticipantStateMachine>&)> _call_at_state;
+        };
+
+        static TransitionInfo getTransitionInfo(Transition transition)
+        {
+            std::string name;
+            std::string logging_info;
+            bool init_false_start_true = false;
+            bool reverse_prio = false;
+            std::function<void(RPCComponent<rpc::IRPCParticipantStateMachine>&)> call_at_state;
+            switch (transition)
+            {
+                case Transition::load:
+                    name = "load";
+                    logging_info = "loaded";
+                    reverse_prio = true;
+                    call_at_state = [](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
                     {
-                        call_at_state(state_machine);
-                    }
-                    catch (const std::exception& ex)
+                        state_machine->load();
+                    };
+                    break;
+                case Transition::unload:
+                    name = "unload";
+                    logging_info = "unloaded";
+                    call_at_state = [](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
                     {
-                        error_message += std::string(" ") + ex.what();
-                    }
-                }
-            });
-            if (!error_message.empty())
+                        state_machine->unload();
+                    };
+                    break;
+                case Transition::initialize:
+                    name = "initialize";
+                    logging_info = "initialized";
+                    reverse_prio = true;
+                    call_at_state = [](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+                    {
+                        state_machine->initialize();
+                    };
+                    break;
+                case Transition::deinitialize:
+                    name = "deinitialize";
+                    logging_info = "deinitialized";
+                    call_at_state = [](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+                    {
+                        state_machine->deinitialize();
+                    };
+                    break;
+                case Transition::start:
+                    name = "start";
+                    logging_info = "started";
+                    init_false_start_true = true;
+                    reverse_prio = true;
+                    call_at_state = [](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+                    {
+                        state_machine->start();
+                    };
+                    break;
+                case Transition::pause:
+                    name = "pause";
+                    logging_info = "paused";
+                    reverse_prio = true;
+                    call_at_state = [](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+                    {
+                        state_machine->pause();
+                    };
+                    break;
+                case Transition::stop:
+                    name = "stop";
+                    logging_info = "stopped";
+                    call_at_state = [](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+                    {
+                        state_machine->stop();
+                    };
+                    break;
+                case Transition::shutdown:
+                    name = "shutdown";
+                    logging_info = "shutdowned";
+                    call_at_state = [](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+                    {
+                        state_machine->shutdown();
+                    };
+                    break;
+            }
+
+            return { name, logging_info, init_false_start_true, reverse_prio, call_at_state };
+        }
+
+        ///calls the transition at the participant and returns its error message
+        static std::string callTransition(const ParticipantProxy& part,
+            const std::function<void(RPCComponent<rpc::IRPCParticipantStateMachine>&)>& call_at_state)
+        {
+            auto state_machine = part.getRPCComponentProxyByIID<rpc::IRPCParticipantStateMachine>();
+            if (state_machine)
             {
-                FEP3_SYSTEM_LOG_AND_THROW(
-                    _logger,
-                    logging::Severity::fatal,
-                    "",
-                    _system_name,
-                    error_message);
+                try
+                {
+                    call_at_state(state_machine);
+                }
+                catch (const std::exception& ex)
+                {
+                    return std::string(" ") + ex.what();
+                }
             }
+            return {};
+        }
 
-            _logger->log(logging::Severity::info, "",
-                _system_name, "system " + logging_info + " successfully");
+        ///called after a transition phase with the collected error messages (empty if successful)
+        using TransitionFinished = std::function<void(SystemOperation::Implementation& operation,
+            const std::string& error_message)>;
+
+        /**
+         * Creates the phase calling @p transition at every participant by priority levels
+         * (or by their dependencies if there are any).
+         * Without @p finished the phase (and with it the operation) fails with the collected error messages
+         * of the participants and the participants which missed the deadline.
+         * @remark the phase may be executed after the system was changed, so it only uses the given values.
+         */
+        static OperationPhase createTransitionPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            Transition transition,
+            std::chrono::milliseconds timeout,
+            const TransitionFinished& finished = {})
+        {
+            return createTransitionPhase(logger, system_name, participants, getIndexes(participants),
+                transition, timeout, finished);
         }
-        
 
-        void setSystemState(System::AggregatedState state, std::chrono::milliseconds timeout)
+        /**
+         * Creates the phase calling @p transition at every participant by the levels of the @p priority_index
+         * (or by their dependencies if there are any), @p participants are the ordered participants of the index.
+         */
+        static OperationPhase createTransitionPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            PriorityIndex& priority_index,
+            Transition transition,
+            std::chrono::milliseconds timeout)
         {
-            if (state == System::AggregatedState::unreachable
-                || state == System::AggregatedState::undefined)
+            const auto info = getTransitionInfo(transition);
+            if (transition == Transition::shutdown || hasDependencies(participants, info._init_false_start_true))
             {
-                FEP3_SYSTEM_LOG_AND_THROW(_logger,
-                    logging::Severity::error,
-                    "",
-                    getName(),
-                    "Invalid setSystemState call at system " + getName());
+                return createTransitionPhase(logger, system_name, participants, transition, timeout);
             }
-            auto currentState = getSystemState(timeout);
-            if (currentState._state == System::AggregatedState::unreachable)
+            return createTransitionPhase(logger, system_name, participants, getIndexes(participants), transition, timeout, {},
+                priority_index.getLevels(participants, info._init_false_start_true, info._reverse_prio));
+        }
+
+        /**
+         * Creates the phase calling @p transition at the @p indexes of @p participants only.
+         * Given @p priority_levels (of all @p participants) are used instead of the dependencies and priorities.
+         */
+        static OperationPhase createTransitionPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            const std::vector<size_t>& indexes,
+            Transition transition,
+            std::chrono::milliseconds timeout,
+            const TransitionFinished& finished = {},
+            const std::shared_ptr<const PriorityIndex::Levels>& priority_levels = {})
+        {
+            const auto info = getTransitionInfo(transition);
+            const auto& logging_info = info._logging_info;
+            const auto& call_at_state = info._call_at_state;
+
+            OperationPhase phase;
+            if (transition == Transition::shutdown)
             {
-                FEP3_SYSTEM_LOG_AND_THROW(_logger,
-                    logging::Severity::error,
-                    "",
-                    getName(),
-                    "At least one participant is unreachable, can not set homogenous state of the system " + getName());
+                //shutdown has no prio, the participants are called concurrently (see _max_concurrent_calls)
+                phase._levels.push_back(indexes);
             }
-            else if (currentState._state == System::AggregatedState::undefined)
+            else if (priority_levels)
             {
-                FEP3_SYSTEM_LOG_AND_THROW(_logger,
-                    logging::Severity::error,
-                    "",
-                    getName(),
-                    "No participant has a statemachine, can not set homogenous state of the system " + getName());
+                phase._shared_levels = priority_levels;
             }
-            else if (currentState._state == state)
+            else
             {
-                if (currentState._homogeneous)
+                std::vector<std::vector<size_t>> predecessors(participants.size());
+                if (addDependencies(participants, indexes, info._init_false_start_true, info._reverse_prio, predecessors))
                 {
-                    return;
+                    setDependencyOrder(logger, system_name, phase, participants, indexes, predecessors);
                 }
                 else
                 {
-                    FEP3_SYSTEM_LOG_AND_THROW(_logger,
-                        logging::Severity::error,
-                        "",
-                        getName(),
-                        "No homogenous state of the participants, setSystemState is not possible at system " + getName());
+                    phase._levels = getPriorityLevels(participants, indexes, info._init_false_start_true, info._reverse_prio);
                 }
             }
-            else if (currentState._state > state)
+            phase._timeout = timeout;
+            phase._reached_state = getTargetState(transition);
+            phase._call_names.resize(participants.size());
+            for (auto index : indexes)
             {
-                if (currentState._state == System::AggregatedState::running)
-                {
-                    if (state == System::AggregatedState::paused)
-                    {
-                        pause(timeout);
-                    }
-                    else
-                    {
-                        stop(timeout);
-                    }
-                }
-                else if (currentState._state == System::AggregatedState::paused)
-                {
-                    stop(timeout);
-                }
-                else if (currentState._state == System::AggregatedState::initialized)
-                {
-                    deinitialize(timeout);
-                }
-                else if (currentState._state == System::AggregatedState::loaded)
-                {
-                    unload(timeout);
-                }
-                setSystemState(state, timeout);
-                return;
+                phase._call_names[index] = info._name;
             }
-            else if (currentState._state < state)
+            phase._call = [call_at_state](size_t, const ParticipantProxy& part) -> std::string
             {
-                if (currentState._state == System::AggregatedState::unloaded)
-                {
-                    load(timeout);
-                }
-                else if (currentState._state == System::AggregatedState::loaded)
+                return callTransition(part, call_at_state);
+            };
+            phase._finished = [logger, system_name, timeout, logging_info, finished](
+                SystemOperation::Implementation& operation,
+                const OperationPhase::Result& result)
+            {
+                auto error_message = result._error_message;
+                if (!result._missed_deadline.empty())
                 {
-                    initialize(timeout);
+                    error_message += getMissedDeadlineMessage(timeout, operation.getParticipants(), result);
                 }
-                else if (currentState._state == System::AggregatedState::initialized)
+                if (!error_message.empty())
                 {
-                    if (state == System::AggregatedState::paused)
-                    {
-                        pause(timeout);
-                    }
-                    else
+                    if (!finished)
                     {
-                        start(timeout);
+                        FEP3_SYSTEM_LOG_AND_THROW(
+                            logger,
+                            logging::Severity::fatal,
+                            "",
+                            system_name,
+                            error_message);
                     }
+                    logger->log(logging::Severity::fatal, "", system_name, error_message);
                 }
-                else if (currentState._state == System::AggregatedState::paused)
+                else
                 {
-                    start(timeout);
+                    logger->log(logging::Severity::info, "",
+                        system_name, "system " + logging_info + " successfully");
                 }
-                setSystemState(state, timeout);
-                return;
+                if (finished)
+                {
+                    finished(operation, error_message);
+                }
+            };
+            return phase;
+        }
+
+        /**
+         * Gets the host of @p url (i.e. "host" of "http://host:9090/path"), empty if there is none.
+         */
+        static std::string getHost(const std::string& url)
+        {
+            auto host_begin = url.find("://");
+            host_begin = (host_begin == std::string::npos) ? 0 : host_begin + 3;
+            if (host_begin < url.size() && url[host_begin] == '[')
+            {
+                //IPv6 address
+                const auto host_end = url.find(']', host_begin);
+                return (host_end == std::string::npos) ? std::string() : url.substr(host_begin, host_end - host_begin + 1);
             }
+            const auto host_end = url.find_first_of(":/?#", host_begin);
+            return url.substr(host_begin, (host_end == std::string::npos) ? std::string::npos : host_end - host_begin);
         }
 
-        void load(std::chrono::milliseconds timeout )
+        /**
+         * Creates an operation working on the current participants of the system.
+         * The operation is cancelled if the system is destroyed.
+         */
+        std::shared_ptr<SystemOperation::Implementation> createOperation(const std::string& operation_name)
         {
-            reverse_state_change(timeout, "loaded", false, 
-                [&](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
-                { 
-                    if (state_machine)
-                    {
-                        state_machine->load();
-                    }
-                });
+            return createOperation(operation_name, _participants.getOrdered());
         }
 
-        void unload(std::chrono::milliseconds timeout )
+        /**
+         * Creates an operation working on the given @p participants of the system only.
+         */
+        std::shared_ptr<SystemOperation::Implementation> createOperation(const std::string& operation_name,
+            const std::vector<ParticipantProxy>& participants)
         {
-            normal_state_change(timeout, "unloaded", false,
-                [&](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+            auto operation = std::make_shared<SystemOperation::Implementation>(_worker_pool,
+                participants,
+                operation_name + " of system " + _system_name);
+            operation->setTraceName(_system_name, operation_name);
+            if (_host_concurrency != 0)
             {
-                if (state_machine)
+                std::vector<std::string> hosts;
+                for (const auto& participant : participants)
                 {
-                    state_machine->unload();
+                    hosts.push_back(getHost(participant.getUrl()));
                 }
+                operation->setHostLimit(hosts, _host_concurrency);
+            }
+            auto state_mirror = _state_mirror;
+            operation->setStateObserver([state_mirror](const std::string& participant_name, SystemAggregatedState state)
+            {
+                state_mirror->update(participant_name, state);
+            });
+            auto latency_history = _latency_history;
+            auto learned_latencies = _learned_latencies;
+            operation->setLatencyObserver([latency_history, learned_latencies](const std::string& call_name,
+                const std::string& participant_name,
+                std::chrono::steady_clock::duration duration)
+            {
+                latency_history->record(call_name, participant_name, duration);
+                learned_latencies->record(call_name, participant_name, duration);
             });
+            operation->setProgressObserver(std::make_shared<TransitionProgressReporter>(_logger, _monitor_events, participants));
+            if (_adaptive_timeouts)
+            {
+                const auto factor = _adaptive_timeout_factor;
+                const auto floor = _adaptive_timeout_floor;
+                const auto ceiling = _adaptive_timeout_ceiling;
+                operation->setCallTimeout([learned_latencies, factor, floor, ceiling](const std::string& call_name,
+                    const std::string& participant_name)
+                {
+                    return getAdaptiveTimeout(*learned_latencies, call_name, participant_name, factor, floor, ceiling);
+                });
+            }
+            trackOperation(operation);
+            return operation;
         }
 
-        void initialize(std::chrono::milliseconds timeout)
+        /**
+         * Takes over the settings of @p other (see System::System(const System&) and System::operator=),
+         * the participants are not changed. The lazy connection is not taken over,
+         * it must be set before the participants are added.
+         */
+        void copySettingsFrom(const Implementation& other)
         {
-            reverse_state_change(timeout, "initialized", false,
-                [&](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
-            {
-                if (state_machine)
+            setShutdownConcurrency(other.getShutdownConcurrency());
+            setPreflightCheck(other.getPreflightCheck(), other.getPreflightTimeout());
+            setIdempotentTransitions(other.getIdempotentTransitions());
+            setHostConcurrency(other.getHostConcurrency());
+            setStateMirror(other.getStateMirror(),
+                other.getReconciliationInterval(),
+                other.getMaxStateStaleness());
+            setHealthMonitor(other.getHealthMonitor(),
+                other.getHealthMinInterval(),
+                other.getHealthMaxInterval());
+            setQueryCache(other.getQueryCache());
+            _learned_latencies = other._learned_latencies;
+            setAdaptiveTimeouts(other.getAdaptiveTimeouts(),
+                other.getAdaptiveTimeoutFactor(),
+                other.getAdaptiveTimeoutFloor(),
+                other.getAdaptiveTimeoutCeiling());
+        }
+
+        ///the operation is cancelled by the destruction of the system, the finished ones are forgotten
+        void trackOperation(const std::shared_ptr<SystemOperation::Implementation>& operation)
+        {
+            std::lock_guard<std::mutex> lock(_sync_operations);
+            _operations.erase(std::remove_if(_operations.begin(), _operations.end(),
+                [](const std::weak_ptr<SystemOperation::Implementation>& running_operation)
                 {
-                    state_machine->initialize();
-                }
-            });
+                    auto locked_operation = running_operation.lock();
+                    return !locked_operation || locked_operation->isDone();
+                }), _operations.end());
+            _operations.push_back(operation);
         }
 
-        void deinitialize(std::chrono::milliseconds timeout )
+        void cancelOperations()
         {
-            normal_state_change(timeout, "deinitialized", false,
-                [&](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+            std::lock_guard<std::mutex> lock(_sync_operations);
+            for (auto& running_operation : _operations)
             {
-                if (state_machine)
+                auto locked_operation = running_operation.lock();
+                if (locked_operation)
                 {
-                    state_machine->deinitialize();
+                    locked_operation->cancel();
                 }
-            });
+            }
+            _operations.clear();
         }
 
-        void start(std::chrono::milliseconds timeout)
+        ///called after a probe phase with the reachability of the participants by index
+        using ProbeFinished = std::function<void(SystemOperation::Implementation& operation, const std::vector<bool>& reached)>;
+
+        /**
+         * Creates the phase probing every participant concurrently by the cheapest call available
+         * (getName of the cached participant info).
+         * Participants which do not answer until the @p timeout is reached are not reachable.
+         */
+        static OperationPhase createProbePhase(const std::vector<ParticipantProxy>& participants,
+            std::chrono::milliseconds timeout,
+            const ProbeFinished& finished)
         {
-            reverse_state_change(timeout, "started", true,
-                [&](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+            struct ProbeResult
             {
-                if (state_machine)
+                std::mutex _sync;
+                std::vector<bool> _reached;
+            };
+            auto probe_result = std::make_shared<ProbeResult>();
+            probe_result->_reached.resize(participants.size(), false);
+
+            OperationPhase phase;
+            phase._levels.push_back(getIndexes(participants));
+            phase._timeout = timeout;
+            phase._report_progress = false;
+            phase._limit_per_host = false;
+            phase._call = [probe_result](size_t participant_index, const ParticipantProxy& part) -> std::string
+            {
+                try
                 {
-                    state_machine->start();
+                    auto part_info = part.getRPCComponentProxyByIID<rpc::arya::IRPCParticipantInfo>();
+                    //the proxy answers an empty name if the participant can not be reached
+                    if (part_info && !part_info->getName().empty())
+                    {
+                        std::lock_guard<std::mutex> lock(probe_result->_sync);
+                        probe_result->_reached[participant_index] = true;
+                    }
                 }
-            });
+                catch (...)
+                {
+                    //not reached
+                }
+                return {};
+            };
+            phase._finished = [probe_result, finished](SystemOperation::Implementation& operation,
+                const OperationPhase::Result&)
+            {
+                std::vector<bool> reached;
+                {
+                    std::lock_guard<std::mutex> lock(probe_result->_sync);
+                    reached = probe_result->_reached;
+                }
+                finished(operation, reached);
+            };
+            return phase;
         }
-        
-        void pause(std::chrono::milliseconds timeout )
+
+        /**
+         * Creates the phase probing every participant concurrently with a short @p timeout.
+         * The operation is aborted with the list of the participants which can not be reached,
+         * before any of them was asked for a transition.
+         */
+        static OperationPhase createPreflightPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::string& operation_name,
+            const std::vector<ParticipantProxy>& participants,
+            std::chrono::milliseconds timeout)
         {
-            reverse_state_change(timeout, "paused", false,
-                [&](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+            return createProbePhase(participants, timeout,
+                [logger, system_name, operation_name, participants](SystemOperation::Implementation&,
+                    const std::vector<bool>& reached)
             {
-                if (state_machine)
+                std::vector<std::string> unreachable_participants;
+                for (size_t index = 0; index < participants.size(); ++index)
+                {
+                    if (!reached[index])
+                    {
+                        unreachable_participants.push_back(participants[index].getName());
+                    }
+                }
+                if (!unreachable_participants.empty())
                 {
-                    state_machine->pause();
+                    FEP3_SYSTEM_LOG_AND_THROW(logger,
+                        logging::Severity::error,
+                        "",
+                        system_name,
+                        "Participants " + join(unreachable_participants, ", ") + " are unreachable, "
+                        + operation_name + " of system " + system_name + " aborted");
                 }
             });
         }
-        void stop(std::chrono::milliseconds timeout )
+
+        void addPreflightPhase(SystemOperation::Implementation& operation, const std::string& operation_name)
+        {
+            if (_preflight_check)
+            {
+                operation.addPhase(createPreflightPhase(_logger, _system_name, operation_name,
+                    _participants.getOrdered(), _preflight_timeout));
+            }
+        }
+
+        ///state of a participant after @p transition
+        static System::AggregatedState getTargetState(Transition transition)
+        {
+            switch (transition)
+            {
+                case Transition::load:
+                case Transition::deinitialize:
+                    return System::AggregatedState::loaded;
+                case Transition::unload:
+                    return System::AggregatedState::unloaded;
+                case Transition::initialize:
+                case Transition::stop:
+                    return System::AggregatedState::initialized;
+                case Transition::start:
+                    return System::AggregatedState::running;
+                case Transition::pause:
+                    return System::AggregatedState::paused;
+                default:
+                    return System::AggregatedState::unreachable;
+            }
+        }
+
+        /**
+         * Creates the phase requesting the states of the participants once
+         * and calling @p transition only at the participants which are not in its target state yet.
+         * Participants without a statemachine are skipped, unreachable participants are called
+         * (to report them like without the snapshot).
+         */
+        static OperationPhase createIdempotentTransitionPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            Transition transition,
+            std::chrono::milliseconds timeout)
         {
-            normal_state_change(timeout, "stopped", false,
-                [&](RPCComponent<rpc::IRPCParticipantStateMachine>& state_machine)
+            return createStateRequestPhase(participants, timeout,
+                [logger, system_name, participants, transition, timeout](
+                    SystemOperation::Implementation& operation,
+                    const PartStates& states)
             {
-                if (state_machine)
+                const auto target_state = getTargetState(transition);
+                std::vector<size_t> indexes;
+                for (size_t index = 0; index < participants.size(); ++index)
                 {
-                    state_machine->stop();
+                    const auto part_state = states[index];
+                    if (part_state == target_state || part_state == System::AggregatedState::undefined)
+                    {
+                        operation.skip(index);
+                    }
+                    else
+                    {
+                        indexes.push_back(index);
+                    }
                 }
+                operation.addPhase(createTransitionPhase(logger, system_name, participants, indexes, transition, timeout));
             });
         }
 
-        void shutdown(std::chrono::milliseconds )
+        SystemOperation change_state(const std::string& operation_name,
+            Transition transition,
+            std::chrono::milliseconds timeout)
         {
+            auto operation = createOperation(operation_name);
             if (_participants.empty())
             {
                 _logger->log(logging::Severity::warning, "",
-                    _system_name + ".system", "No participants within the current system");
-                return;
+                    transition == Transition::shutdown ? _system_name + ".system" : _system_name,
+                    "No participants within the current system");
             }
-            std::string error_message;
-            //shutdown has no prio
-            for (auto& part : _participants)
+            else
             {
-                auto state_machine = part.getRPCComponentProxyByIID<rpc::IRPCParticipantStateMachine>();
-                if (state_machine)
+                try
                 {
-                    try
+                    if (transition != Transition::shutdown)
                     {
-                        state_machine->shutdown();
+                        //a participant which is already shut down is fine for the shutdown
+                        addPreflightPhase(*operation, operation_name);
+                    }
+                    if (_idempotent_transitions && transition != Transition::shutdown)
+                    {
+                        operation->addPhase(createIdempotentTransitionPhase(_logger, _system_name, _participants.getOrdered(),
+                            transition, timeout));
                     }
-                    catch (const std::exception& ex)
+                    else
                     {
-                        error_message += std::string(" ") + ex.what();
+                        auto phase = createTransitionPhase(_logger, _system_name, _participants.getOrdered(),
+                            _priority_index, transition, timeout);
+                        if (transition == Transition::shutdown)
+                        {
+                            phase._max_concurrent_calls = _shutdown_concurrency;
+                        }
+                        operation->addPhase(std::move(phase));
                     }
                 }
+                catch (...)
+                {
+                    operation->fail(std::current_exception());
+                }
             }
-            if (!error_message.empty())
+            operation->start();
+            return SystemOperation(operation);
+        }
+
+        ///states of the participants of a state request phase, in order of the participants
+        typedef std::vector<rpc::arya::IRPCParticipantStateMachine::State> PartStates;
+
+        ///called with the states of the participants after a state request phase
+        using StatesReceived = std::function<void(SystemOperation::Implementation& operation, const PartStates& states)>;
+
+        /**
+         * Called with the states of the participants after a state request phase and whether each participant
+         * answered before the timeout (the state of a participant which did not answer is unreachable).
+         */
+        using StatesAnswered = std::function<void(SystemOperation::Implementation& operation,
+            const PartStates& states,
+            const std::vector<bool>& answered)>;
+
+        /**
+         * Creates the phase requesting the states of all participants concurrently.
+         * Participants which do not answer until the timeout is reached are considered as unreachable.
+         */
+        static OperationPhase createStateRequestPhase(const std::vector<ParticipantProxy>& participants,
+            std::chrono::milliseconds timeout,
+            const StatesReceived& received)
+        {
+            return createStateRequestPhase(std::make_shared<StateMachineClients>(participants), timeout,
+                [received](SystemOperation::Implementation& operation, const PartStates& states, const std::vector<bool>&)
             {
-                FEP3_SYSTEM_LOG_AND_THROW(
-                    _logger,
-                    logging::Severity::fatal,
-                    "",
-                    _system_name,
-                    error_message);
-            }
-            _logger->log(logging::Severity::info, "",
-                _system_name, "system shutdowned successfully");
+                received(operation, states);
+            });
         }
 
-        std::string getName()
+        /**
+         * Creates the phase requesting the states of the participants of @p state_machines concurrently
+         * (the operation must have the same participants).
+         * The states are collected by participant index within a table allocated once for the phase.
+         * Only the answered states are reported to the state observer of the operation, a participant which
+         * missed the timeout is not known to be unreachable.
+         */
+        static OperationPhase createStateRequestPhase(const std::shared_ptr<StateMachineClients>& state_machines,
+            std::chrono::milliseconds timeout,
+            const StatesAnswered& received)
         {
-            return _system_name;
+            struct StateRequest
+            {
+                std::mutex _sync;
+                PartStates _states;
+                bool _finished = false;
+            };
+            const auto participant_count = state_machines->getParticipants().size();
+            auto request = std::make_shared<StateRequest>();
+            request->_states.resize(participant_count, rpc::arya::IRPCParticipantStateMachine::State::unreachable);
+
+            OperationPhase phase;
+            phase._levels.push_back(getIndexes(state_machines->getParticipants()));
+            phase._timeout = timeout;
+            phase._report_progress = false;
+            phase._limit_per_host = false;
+            phase._call = [request, state_machines](size_t participant_index, const ParticipantProxy&) -> std::string
+            {
+                auto part_state = state_machines->requestState(participant_index);
+                std::lock_guard<std::mutex> lock(request->_sync);
+                if (!request->_finished)
+                {
+                    request->_states[participant_index] = part_state;
+                }
+                return {};
+            };
+            phase._finished = [request, received](SystemOperation::Implementation& operation,
+                const OperationPhase::Result& result)
+            {
+                PartStates states;
+                {
+                    //answers arriving from now on are ignored
+                    std::lock_guard<std::mutex> lock(request->_sync);
+                    request->_finished = true;
+                    states = std::move(request->_states);
+                }
+                std::vector<bool> answered(states.size(), true);
+                //the operation has the participants of the state machines, so the indexes are the same
+                for (const auto missed_participant : result._missed_deadline)
+                {
+                    states[missed_participant] = rpc::arya::IRPCParticipantStateMachine::State::unreachable;
+                    answered[missed_participant] = false;
+                }
+                for (size_t index = 0; index < states.size(); ++index)
+                {
+                    if (answered[index])
+                    {
+                        operation.reportState(index, states[index]);
+                    }
+                }
+                received(operation, states, answered);
+            };
+            return phase;
         }
 
-        std::string getUrl()
+        static std::string getStateName(System::AggregatedState state)
+        {
+            switch (state)
+            {
+                case System::AggregatedState::unreachable:
+                    return "unreachable";
+                case System::AggregatedState::unloaded:
+                    return "unloaded";
+                case System::AggregatedState::loaded:
+                    return "loaded";
+                case System::AggregatedState::initialized:
+                    return "initialized";
+                case System::AggregatedState::paused:
+                    return "paused";
+                case System::AggregatedState::running:
+                    return "running";
+                default:
+                    return "undefined";
+            }
+        }
+
+        /**
+         * Plans the transitions to get from the state @p current to @p target.
+         * i.e. unloaded to running is load, initialize, start
+         */
+        static std::vector<Transition> planTransitions(System::AggregatedState current, System::AggregatedState target)
+        {
+            std::vector<Transition> plan;
+            while (current != target)
+            {
+                if (current > target)
+                {
+                    if (current == System::AggregatedState::running && target == System::AggregatedState::paused)
+                    {
+                        plan.push_back(Transition::pause);
+                        current = System::AggregatedState::paused;
+                    }
+                    else if (current == System::AggregatedState::running
+                        || current == System::AggregatedState::paused)
+                    {
+                        plan.push_back(Transition::stop);
+                        current = System::AggregatedState::initialized;
+                    }
+                    else if (current == System::AggregatedState::initialized)
+                    {
+                        plan.push_back(Transition::deinitialize);
+                        current = System::AggregatedState::loaded;
+                    }
+                    else
+                    {
+                        plan.push_back(Transition::unload);
+                        current = System::AggregatedState::unloaded;
+                    }
+                }
+                else
+                {
+                    if (current == System::AggregatedState::unloaded)
+                    {
+                        plan.push_back(Transition::load);
+                        current = System::AggregatedState::loaded;
+                    }
+                    else if (current == System::AggregatedState::loaded)
+                    {
+                        plan.push_back(Transition::initialize);
+                        current = System::AggregatedState::initialized;
+                    }
+                    else if (current == System::AggregatedState::initialized
+                        && target == System::AggregatedState::paused)
+                    {
+                        plan.push_back(Transition::pause);
+                        current = System::AggregatedState::paused;
+                    }
+                    else
+                    {
+                        plan.push_back(Transition::start);
+                        current = System::AggregatedState::running;
+                    }
+                }
+            }
+            return plan;
+        }
+
+        /**
+         * Creates the phase requesting the states of the participants after the planned transitions
+         * (or after one of them failed).
+         * The operation fails with @p error_message of the failed transition
+         * or if @p state is not reached homogenously.
+         */
+        static OperationPhase createVerifyPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::string& operation_name,
+            const std::vector<ParticipantProxy>& participants,
+            System::AggregatedState state,
+            std::chrono::milliseconds timeout,
+            const std::string& error_message)
+        {
+            return createStateRequestPhase(participants, timeout,
+                [logger, system_name, operation_name, state, error_message](SystemOperation::Implementation&,
+                    const PartStates& states)
+            {
+                auto reached_state = getAggregatedState(states);
+                if (!error_message.empty())
+                {
+                    logger->log(logging::Severity::warning, "", system_name,
+                        operation_name + " stopped at state " + getStateName(reached_state._state)
+                        + (reached_state._homogeneous ? "" : " (not homogenous)") + " of system " + system_name);
+                    throw std::runtime_error(error_message);
+                }
+                if (reached_state._state != state || !reached_state._homogeneous)
+                {
+                    FEP3_SYSTEM_LOG_AND_THROW(logger,
+                        logging::Severity::error,
+                        "",
+                        system_name,
+                        "State " + getStateName(state) + " was not reached homogenously, the system " + system_name
+                        + " is at state " + getStateName(reached_state._state));
+                }
+            });
+        }
+
+        /**
+         * Creates the transition phase of @p plan at @p plan_index.
+         * If it was successful the next transition of the plan follows immediately (without requesting the states),
+         * the states are only requested after the last transition or after a failed transition.
+         */
+        static OperationPhase createPlannedPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            System::AggregatedState state,
+            std::chrono::milliseconds timeout,
+            const std::vector<Transition>& plan,
+            size_t plan_index)
+        {
+            return createTransitionPhase(logger, system_name, participants, plan[plan_index], timeout,
+                [logger, system_name, participants, state, timeout, plan, plan_index](
+                    SystemOperation::Implementation& operation,
+                    const std::string& error_message)
+            {
+                if (error_message.empty() && plan_index + 1 < plan.size())
+                {
+                    operation.addPhase(createPlannedPhase(logger, system_name, participants, state, timeout,
+                        plan, plan_index + 1));
+                }
+                else
+                {
+                    operation.addPhase(createVerifyPhase(logger, system_name, "setSystemState", participants, state,
+                        timeout, error_message));
+                }
+            });
+        }
+
+        /**
+         * Creates the phase requesting the states of the participants once.
+         * From this snapshot the whole path from the aggregated state to @p state is planned
+         * and executed one transition after the other.
+         */
+        static OperationPhase createSystemStatePhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            System::AggregatedState state,
+            std::chrono::milliseconds timeout)
+        {
+            return createStateRequestPhase(participants, timeout,
+                [logger, system_name, participants, state, timeout](SystemOperation::Implementation& operation,
+                    const PartStates& states)
+            {
+                auto currentState = getAggregatedState(states);
+                if (currentState._state == System::AggregatedState::unreachable)
+                {
+                    FEP3_SYSTEM_LOG_AND_THROW(logger,
+                        logging::Severity::error,
+                        "",
+                        system_name,
+                        "At least one participant is unreachable, can not set homogenous state of the system " + system_name);
+                }
+                else if (currentState._state == System::AggregatedState::undefined)
+                {
+                    FEP3_SYSTEM_LOG_AND_THROW(logger,
+                        logging::Severity::error,
+                        "",
+                        system_name,
+                        "No participant has a statemachine, can not set homogenous state of the system " + system_name);
+                }
+                else if (currentState._state == state && !currentState._homogeneous)
+                {
+                    FEP3_SYSTEM_LOG_AND_THROW(logger,
+                        logging::Severity::error,
+                        "",
+                        system_name,
+                        "No homogenous state of the participants, setSystemState is not possible at system " + system_name);
+                }
+                auto plan = planTransitions(currentState._state, state);
+                if (!plan.empty())
+                {
+                    operation.addPhase(createPlannedPhase(logger, system_name, participants, state, timeout, plan, 0));
+                }
+            });
+        }
+
+        ///transitions of one convergence round by participant index
+        using ConvergenceRound = std::map<size_t, Transition>;
+
+        /**
+         * Plans the rounds to bring every participant from its own state to @p target.
+         * The transitions of the participants going down and of the participants going up are
+         * aligned by the state they reach, so one round may contain i.e. stop and load.
+         * Participants without a statemachine are not part of any round.
+         * @throw runtime_error if a participant is unreachable
+         */
+        static std::vector<ConvergenceRound> planConvergence(const std::vector<ParticipantProxy>& participants,
+            const PartStates& states,
+            System::AggregatedState target)
+        {
+            const std::vector<Transition> down_stages = (target == System::AggregatedState::paused)
+                ? std::vector<Transition>{ Transition::pause }
+                : std::vector<Transition>{ Transition::stop, Transition::deinitialize, Transition::unload };
+            const std::vector<Transition> up_stages{ Transition::load,
+                Transition::initialize,
+                (target == System::AggregatedState::paused) ? Transition::pause : Transition::start };
+
+            std::vector<ConvergenceRound> rounds(std::max(down_stages.size(), up_stages.size()));
+            std::vector<std::string> unreachable_participants;
+            for (size_t index = 0; index < participants.size(); ++index)
+            {
+                const auto part_state = states[index];
+                if (part_state == System::AggregatedState::undefined)
+                {
+                    continue;
+                }
+                if (part_state == System::AggregatedState::unreachable)
+                {
+                    unreachable_participants.push_back(participants[index].getName());
+                    continue;
+                }
+                const auto& stages = (part_state > target) ? down_stages : up_stages;
+                for (auto transition : planTransitions(part_state, target))
+                {
+                    const auto stage = std::find(stages.begin(), stages.end(), transition) - stages.begin();
+                    rounds[static_cast<size_t>(stage)][index] = transition;
+                }
+            }
+            if (!unreachable_participants.empty())
+            {
+                throw std::runtime_error("Participants " + join(unreachable_participants, ", ")
+                    + " are unreachable, can not converge");
+            }
+            rounds.erase(std::remove_if(rounds.begin(), rounds.end(),
+                [](const ConvergenceRound& round) { return round.empty(); }), rounds.end());
+            return rounds;
+        }
+
+        /**
+         * Creates the phase calling the transitions of one convergence round.
+         * The participants of one transition are called by the priority levels (or the dependencies) of the transition,
+         * the levels of different transitions run side by side.
+         */
+        static OperationPhase createConvergenceRoundPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            const ConvergenceRound& round,
+            std::chrono::milliseconds timeout,
+            const TransitionFinished& finished)
+        {
+            std::map<Transition, std::vector<size_t>> participants_by_transition;
+            for (const auto& participant_transition : round)
+            {
+                participants_by_transition[participant_transition.second].push_back(participant_transition.first);
+            }
+            OperationPhase phase;
+            phase._call_names.resize(participants.size());
+            std::map<size_t, std::function<void(RPCComponent<rpc::IRPCParticipantStateMachine>&)>> calls;
+            std::vector<size_t> indexes;
+            std::vector<std::vector<size_t>> predecessors(participants.size());
+            bool has_dependencies = false;
+            for (const auto& transition_participants : participants_by_transition)
+            {
+                const auto info = getTransitionInfo(transition_participants.first);
+                indexes.insert(indexes.end(), transition_participants.second.begin(), transition_participants.second.end());
+                if (addDependencies(participants, transition_participants.second,
+                    info._init_false_start_true, info._reverse_prio, predecessors))
+                {
+                    has_dependencies = true;
+                }
+                const auto levels = getPriorityLevels(participants, transition_participants.second,
+                    info._init_false_start_true, info._reverse_prio);
+                if (phase._levels.size() < levels.size())
+                {
+                    phase._levels.resize(levels.size());
+                }
+                for (size_t level = 0; level < levels.size(); ++level)
+                {
+                    phase._levels[level].insert(phase._levels[level].end(), levels[level].begin(), levels[level].end());
+                }
+                for (auto index : transition_participants.second)
+                {
+                    calls[index] = info._call_at_state;
+                    phase._call_names[index] = info._name;
+                }
+            }
+            if (has_dependencies)
+            {
+                setDependencyOrder(logger, system_name, phase, participants, indexes, predecessors);
+            }
+            phase._timeout = timeout;
+            phase._call = [calls](size_t participant_index, const ParticipantProxy& part) -> std::string
+            {
+                return callTransition(part, calls.at(participant_index));
+            };
+            phase._finished = [logger, system_name, timeout, finished](SystemOperation::Implementation& operation,
+                const OperationPhase::Result& result)
+            {
+                auto error_message = result._error_message;
+                if (!result._missed_deadline.empty())
+                {
+                    error_message += getMissedDeadlineMessage(timeout, operation.getParticipants(), result);
+                }
+                if (!error_message.empty())
+                {
+                    logger->log(logging::Severity::fatal, "", system_name, error_message);
+                }
+                finished(operation, error_message);
+            };
+            return phase;
+        }
+
+        static OperationPhase createConvergenceRoundsPhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            System::AggregatedState state,
+            std::chrono::milliseconds timeout,
+            const std::vector<ConvergenceRound>& rounds,
+            size_t round_index)
+        {
+            return createConvergenceRoundPhase(logger, system_name, participants, rounds[round_index], timeout,
+                [logger, system_name, participants, state, timeout, rounds, round_index](
+                    SystemOperation::Implementation& operation,
+                    const std::string& error_message)
+            {
+                if (error_message.empty() && round_index + 1 < rounds.size())
+                {
+                    operation.addPhase(createConvergenceRoundsPhase(logger, system_name, participants, state, timeout,
+                        rounds, round_index + 1));
+                }
+                else
+                {
+                    operation.addPhase(createVerifyPhase(logger, system_name, "convergeSystemState", participants,
+                        state, timeout, error_message));
+                }
+            });
+        }
+
+        /**
+         * Creates the phase requesting the states of the participants once.
+         * Every participant gets its own path to @p state, the paths are executed concurrently in rounds.
+         */
+        static OperationPhase createConvergencePhase(const std::shared_ptr<SystemLogger>& logger,
+            const std::string& system_name,
+            const std::vector<ParticipantProxy>& participants,
+            System::AggregatedState state,
+            std::chrono::milliseconds timeout)
+        {
+            return createStateRequestPhase(participants, timeout,
+                [logger, system_name, participants, state, timeout](SystemOperation::Implementation& operation,
+                    const PartStates& states)
+            {
+                if (getAggregatedState(states)._state == System::AggregatedState::undefined)
+                {
+                    FEP3_SYSTEM_LOG_AND_THROW(logger,
+                        logging::Severity::error,
+                        "",
+                        system_name,
+                        "No participant has a statemachine, can not converge the system " + system_name);
+                }
+                std::vector<ConvergenceRound> rounds;
+                try
+                {
+                    rounds = planConvergence(participants, states, state);
+                }
+                catch (const std::exception& ex)
+                {
+                    FEP3_SYSTEM_LOG_AND_THROW(logger,
+                        logging::Severity::error,
+                        "",
+                        system_name,
+                        std::string(ex.what()) + " the system " + system_name);
+                }
+                if (!rounds.empty())
+                {
+                    operation.addPhase(createConvergenceRoundsPhase(logger, system_name, participants, state, timeout,
+                        rounds, 0));
+                }
+            });
+        }
+
+        SystemOperation convergeSystemState(System::AggregatedState state, std::chrono::milliseconds timeout)
+        {
+            if (state == System::AggregatedState::unreachable
+                || state == System::AggregatedState::undefined)
+            {
+                FEP3_SYSTEM_LOG_AND_THROW(_logger,
+                    logging::Severity::error,
+                    "",
+                    getName(),
+                    "Invalid convergeSystemState call at system " + getName());
+            }
+            auto operation = createOperation("convergeSystemState");
+            addPreflightPhase(*operation, "convergeSystemState");
+            operation->addPhase(createConvergencePhase(_logger, _system_name, _participants.getOrdered(), state, timeout));
+            operation->start();
+            return SystemOperation(operation);
+        }
+
+        SystemOperation setSystemState(System::AggregatedState state, std::chrono::milliseconds timeout)
+        {
+            if (state == System::AggregatedState::unreachable
+                || state == System::AggregatedState::undefined)
+            {
+                FEP3_SYSTEM_LOG_AND_THROW(_logger,
+                    logging::Severity::error,
+                    "",
+                    getName(),
+                    "Invalid setSystemState call at system " + getName());
+            }
+            auto operation = createOperation("setSystemState");
+            addPreflightPhase(*operation, "setSystemState");
+            operation->addPhase(createSystemStatePhase(_logger, _system_name, _participants.getOrdered(), state, timeout));
+            operation->start();
+            return SystemOperation(operation);
+        }
+
+        SystemOperation load(std::chrono::milliseconds timeout)
+        {
+            return change_state("load", Transition::load, timeout);
+        }
+
+        SystemOperation unload(std::chrono::milliseconds timeout)
+        {
+            return change_state("unload", Transition::unload, timeout);
+        }
+
+        SystemOperation initialize(std::chrono::milliseconds timeout)
+        {
+            return change_state("initialize", Transition::initialize, timeout);
+        }
+
+        SystemOperation deinitialize(std::chrono::milliseconds timeout)
+        {
+            return change_state("deinitialize", Transition::deinitialize, timeout);
+        }
+
+        SystemOperation start(std::chrono::milliseconds timeout)
+        {
+            return change_state("start", Transition::start, timeout);
+        }
+
+        SystemOperation pause(std::chrono::milliseconds timeout)
+        {
+            return change_state("pause", Transition::pause, timeout);
+        }
+
+        SystemOperation stop(std::chrono::milliseconds timeout)
+        {
+            return change_state("stop", Transition::stop, timeout);
+        }
+
+        SystemOperation shutdown(std::chrono::milliseconds timeout)
+        {
+            return change_state("shutdown", Transition::shutdown, timeout);
+        }
+
+        std::string getName()
+        {
+            return _system_name;
+        }
+
+        void setShutdownConcurrency(size_t max_concurrent_participants)
+        {
+            _shutdown_concurrency = std::max<size_t>(1, max_concurrent_participants);
+        }
+
+        size_t getShutdownConcurrency() const
+        {
+            return _shutdown_concurrency;
+        }
+
+        void setPreflightCheck(bool enable, std::chrono::milliseconds timeout)
+        {
+            _preflight_check = enable;
+            _preflight_timeout = timeout;
+        }
+
+        bool getPreflightCheck() const
+        {
+            return _preflight_check;
+        }
+
+        std::chrono::milliseconds getPreflightTimeout() const
+        {
+            return _preflight_timeout;
+        }
+
+        void setHostConcurrency(size_t max_concurrent_participants)
+        {
+            _host_concurrency = max_concurrent_participants;
+        }
+
+        size_t getHostConcurrency() const
+        {
+            return _host_concurrency;
+        }
+
+        void setIdempotentTransitions(bool enable)
+        {
+            _idempotent_transitions = enable;
+        }
+
+        bool getIdempotentTransitions() const
+        {
+            return _idempotent_transitions;
+        }
+
+        void setLazyConnection(bool enable)
+        {
+            _lazy_connection = enable;
+        }
+
+        bool getLazyConnection() const
+        {
+            return _lazy_connection;
+        }
+
+        std::string getUrl()
+        {
+            return _system_discovery_url;
+        }
+
+        //system state is aggregated
+        //the participants are requested concurrently,
+        //participants which do not answer until the timeout is reached are considered as unreachable,
+        //but keep their last known state within the state mirror
+        System::State requestSystemState(std::chrono::milliseconds timeout)
+        {
+            auto system_state = std::make_shared<System::State>();
+            const auto state_machines = getStateMachineClients();
+            auto operation = createOperation("getSystemState", state_machines->getParticipants());
+            const auto request_time = std::chrono::steady_clock::now();
+            auto state_mirror = _state_mirror;
+            operation->addPhase(createStateRequestPhase(state_machines, timeout,
+                [system_state, state_machines, state_mirror, request_time](SystemOperation::Implementation&,
+                    const PartStates& states,
+                    const std::vector<bool>& answered)
+            {
+                state_mirror->reconcile(state_machines->getParticipants(), states, answered, request_time);
+                *system_state = getAggregatedState(states);
+            }));
+            operation->start();
+            operation->get();
+            return *system_state;
+        }
+
+        /**
+         * Gets the state machine clients of all participants, shared by the state requests of all participants
+         * until the participants of the system change. May be called from any thread.
+         */
+        std::shared_ptr<StateMachineClients> getStateMachineClients()
+        {
+            std::lock_guard<std::mutex> lock(_sync_state_machines);
+            if (!_state_machines)
+            {
+                //the participants of the mirror are the ones of the system, but are safe to access from any thread
+                _state_machines = std::make_shared<StateMachineClients>(_state_mirror->getParticipants());
+            }
+            return _state_machines;
+        }
+
+        ///the participants of the system changed, their clients are resolved again at the next state request
+        void resetStateMachineClients()
+        {
+            std::lock_guard<std::mutex> lock(_sync_state_machines);
+            _state_machines.reset();
+        }
+
+        ///requests the states of @p participants concurrently, the state mirror is updated with the answers
+        void requestStates(const std::vector<ParticipantProxy>& participants, std::chrono::milliseconds timeout)
+        {
+            auto operation = createOperation("requestStates", participants);
+            operation->addPhase(createStateRequestPhase(participants, timeout,
+                [](SystemOperation::Implementation&, const PartStates&)
+            {
+            }));
+            operation->start();
+            operation->get();
+        }
+
+        /**
+         * Waits until @p reached returns true for the state mirror.
+         * The mirror is checked whenever it changes (by the transitions, state requests
+         * or reconciliations). Since participants may change their states silently, @p request_states
+         * is called in addition, first immediately and then with an exponentially growing interval,
+         * as long as the time left is enough for the participants to answer (see min_state_request_timeout).
+         */
+        bool waitForState(const std::function<void(std::chrono::milliseconds timeout)>& request_states,
+            const std::function<bool(const SystemStateMirror& state_mirror)>& reached,
+            std::chrono::milliseconds timeout)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            std::chrono::milliseconds request_interval(min_state_request_interval);
+            while (true)
+            {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+                if (remaining >= std::chrono::milliseconds(min_state_request_timeout))
+                {
+                    request_states(std::min(remaining, FEP_SYSTEM_DEFAULT_TIMEOUT));
+                }
+                auto version = _state_mirror->getVersion();
+                if (reached(*_state_mirror))
+                {
+                    return true;
+                }
+                const auto next_request = std::min(std::chrono::steady_clock::now() + request_interval, deadline);
+                while (_state_mirror->waitForChange(version, next_request))
+                {
+                    version = _state_mirror->getVersion();
+                    if (reached(*_state_mirror))
+                    {
+                        return true;
+                    }
+                }
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+                request_interval = std::min(request_interval * 2, std::chrono::milliseconds(max_state_request_interval));
+            }
+        }
+
+        bool waitForSystemState(System::AggregatedState state, std::chrono::milliseconds timeout)
+        {
+            return waitForState(
+                [this](std::chrono::milliseconds request_timeout)
+            {
+                //the request of all participants reconciles the mirror
+                requestSystemState(request_timeout);
+            },
+                [state](const SystemStateMirror& state_mirror)
+            {
+                System::State system_state;
+                return state_mirror.getState(system_state)
+                    && system_state._homogeneous
+                    && system_state._state == state;
+            }, timeout);
+        }
+
+        bool waitForParticipantState(const std::string& participant_name,
+            System::AggregatedState state,
+            std::chrono::milliseconds timeout)
+        {
+            const auto participant = getParticipant(participant_name, true);
+            return waitForState(
+                [this, participant](std::chrono::milliseconds request_timeout)
+            {
+                requestStates({ participant }, request_timeout);
+            },
+                [participant_name, state](const SystemStateMirror& state_mirror)
+            {
+                System::AggregatedState participant_state;
+                return state_mirror.getState(participant_name, participant_state)
+                    && participant_state == state;
+            }, timeout);
+        }
+
+        static System::State getAggregatedState(const PartStates& states)
+        {
+            //no participant, then we are also undefined
+            if (states.empty())
+            {
+                return { rpc::arya::IRPCParticipantStateMachine::State::undefined };
+            }
+            //we begin at the highest value
+            SystemAggregatedState aggregated_state = SystemAggregatedState::running;
+            //participants without statemachine are not considered, so the order of the participants does not matter
+            bool defined_found = false;
+            bool homogeneous_value = true;
+            for (const auto current_part_state : states)
+            {
+                if (current_part_state == rpc::arya::IRPCParticipantStateMachine::State::undefined)
+                {
+                    continue;
+                }
+                if (defined_found && current_part_state != aggregated_state)
+                {
+                    homogeneous_value = false;
+                }
+                aggregated_state = std::min(aggregated_state, current_part_state);
+                defined_found = true;
+            }
+            return { homogeneous_value , aggregated_state };
+        }
+
+        System::State getSystemState(std::chrono::milliseconds timeout)
+        {
+            System::State state;
+            //the mirror is not used if its reconciliation is overdue (i.e. the participants did not answer)
+            if (_state_mirror_enabled
+                && _state_mirror->getStaleness().count() <= _max_state_staleness
+                && _state_mirror->getState(state))
+            {
+                return state;
+            }
+            //the same request of several threads is shared
+            return _system_state_queries.get(timeout.count(), [this, timeout]()
+            {
+                return requestSystemState(timeout);
+            });
+        }
+
+        ///throws if @p transition is not the name of a transition within the latency history
+        void checkTransitionName(const std::string& transition) const
+        {
+            for (auto known_transition : { Transition::load, Transition::unload, Transition::initialize,
+                Transition::deinitialize, Transition::start, Transition::pause, Transition::stop, Transition::shutdown })
+            {
+                if (getTransitionInfo(known_transition)._name == transition)
+                {
+                    return;
+                }
+            }
+            FEP3_SYSTEM_LOG_AND_THROW(_logger,
+                logging::Severity::error,
+                "",
+                _system_name,
+                "Unknown transition " + transition + ", no latencies of system " + _system_name);
+        }
+
+        TransitionLatencies getTransitionLatencies(const std::string& transition, size_t slowest_count) const
+        {
+            checkTransitionName(transition);
+            return _latency_history->getLatencies(transition, slowest_count);
+        }
+
+        void clearTransitionLatencies()
+        {
+            _latency_history->clear();
+        }
+
+        ///the 99th percentile of the latencies times @p factor within @p floor and @p ceiling, 0 if not enough calls are known
+        static std::chrono::milliseconds getAdaptiveTimeout(const LatencyHistory& latencies,
+            const std::string& call_name,
+            const std::string& participant_name,
+            double factor,
+            std::chrono::milliseconds floor,
+            std::chrono::milliseconds ceiling)
+        {
+            LatencyHistory::Duration latency;
+            if (!latencies.getPercentile(call_name, participant_name, 0.99, FEP_SYSTEM_ADAPTIVE_TIMEOUT_MIN_CALLS, latency))
+            {
+                return std::chrono::milliseconds(0);
+            }
+            const auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::duration<double, std::milli>(latency) * factor);
+            return std::min(std::max(timeout, floor), ceiling);
+        }
+
+        void setAdaptiveTimeouts(bool enable,
+            double factor,
+            std::chrono::milliseconds floor,
+            std::chrono::milliseconds ceiling)
+        {
+            _adaptive_timeouts = enable;
+            _adaptive_timeout_factor = std::max(factor, 1.0);
+            _adaptive_timeout_floor = floor;
+            _adaptive_timeout_ceiling = std::max(floor, ceiling);
+        }
+
+        bool getAdaptiveTimeouts() const
+        {
+            return _adaptive_timeouts;
+        }
+
+        double getAdaptiveTimeoutFactor() const
+        {
+            return _adaptive_timeout_factor;
+        }
+
+        std::chrono::milliseconds getAdaptiveTimeoutFloor() const
+        {
+            return _adaptive_timeout_floor;
+        }
+
+        std::chrono::milliseconds getAdaptiveTimeoutCeiling() const
+        {
+            return _adaptive_timeout_ceiling;
+        }
+
+        std::chrono::milliseconds getAdaptiveTimeout(const std::string& participant_name, const std::string& transition) const
+        {
+            checkTransitionName(transition);
+            return getAdaptiveTimeout(*_learned_latencies, transition, participant_name,
+                _adaptive_timeout_factor, _adaptive_timeout_floor, _adaptive_timeout_ceiling);
+        }
+
+        void setQueryCache(std::chrono::milliseconds max_age)
+        {
+            _system_state_queries.setMaxAge(max_age);
+            _timing_properties_queries.setMaxAge(max_age);
+        }
+
+        std::chrono::milliseconds getQueryCache() const
+        {
+            return _system_state_queries.getMaxAge();
+        }
+
+        void setStateMirror(bool enable,
+            std::chrono::milliseconds reconciliation_interval,
+            std::chrono::milliseconds max_staleness)
+        {
+            stopReconciliation();
+            _state_mirror_enabled = enable;
+            _reconciliation_interval = reconciliation_interval;
+            _max_state_staleness = max_staleness.count();
+            if (enable)
+            {
+                //the first reconciliation is done at once, until then getSystemState requests the participants
+                reconcileStates(_reconciliation_generation, reconciliation_interval);
+            }
+        }
+
+        bool getStateMirror() const
+        {
+            return _state_mirror_enabled;
+        }
+
+        std::chrono::milliseconds getReconciliationInterval() const
+        {
+            return _reconciliation_interval;
+        }
+
+        std::chrono::milliseconds getMaxStateStaleness() const
+        {
+            return std::chrono::milliseconds(_max_state_staleness);
+        }
+
+        std::chrono::milliseconds getStateStaleness() const
+        {
+            return _state_mirror->getStaleness();
+        }
+
+        void setHealthMonitor(bool enable,
+            std::chrono::milliseconds min_interval,
+            std::chrono::milliseconds max_interval)
+        {
+            stopHealthMonitor();
+            _health_monitor_enabled = enable;
+            _health_min_interval = min_interval;
+            _health_max_interval = std::max(min_interval, max_interval);
+            if (enable)
+            {
+                auto health_monitor = std::make_shared<HealthMonitor>();
+                health_monitor->_min_interval = _health_min_interval;
+                health_monitor->_max_interval = _health_max_interval;
+                health_monitor->_interval = _health_min_interval;
+                checkHealth(_health_generation, health_monitor);
+            }
+        }
+
+        bool getHealthMonitor() const
+        {
+            return _health_monitor_enabled;
+        }
+
+        std::chrono::milliseconds getHealthMinInterval() const
+        {
+            return _health_min_interval;
+        }
+
+        std::chrono::milliseconds getHealthMaxInterval() const
+        {
+            return _health_max_interval;
+        }
+
+        void stopHealthMonitor()
         {
-            return _system_discovery_url;
+            ++_health_generation;
         }
 
-        typedef std::map<std::string, rpc::arya::IRPCParticipantStateMachine::State> PartStates;
-        //system state is aggregated
-        //timeout can be only used if the RPC will 
-        // support the changing of it or use for every single Request
-        PartStates getParticipantStates(std::chrono::milliseconds )
+        ///reports a changed reachability to the monitor, delivered in order with the transition progress
+        static void notifyReachability(const std::shared_ptr<SystemLogger>& logger,
+            const std::shared_ptr<WorkerPool>& monitor_events,
+            const std::string& participant_name,
+            bool reachable)
         {
-            
-            PartStates states;
-            for (auto part : _participants)
+            if (!logger->hasMonitor())
             {
-                RPCComponent<rpc::arya::IRPCParticipantInfo> part_info;
-                RPCComponent<rpc::arya::IRPCParticipantStateMachine> state_machine;
-                part_info = part.getRPCComponentProxyByIID<rpc::arya::IRPCParticipantInfo>();
-                state_machine = part.getRPCComponentProxyByIID<rpc::arya::IRPCParticipantStateMachine>();
-                if (state_machine)
-                {
-                    //the participant can not be connected ... maybe it was shutdown or whatever
-                    states[part.getName()] = state_machine->getState();
-                }
-                else
-                {
-                    if (!part_info)
-                    {
-                        //the participant can not be connected ... maybe it was shutdown or whatever
-                        states[part.getName()] = { rpc::arya::IRPCParticipantStateMachine::State::unreachable };
-                    }
-                    else
-                    {
-                        //the participant has no state machine, this is ok 
-                        //... i.e. a recorder will have no states and a signal listener tool will have no states
-                        states[part.getName()] = { rpc::arya::IRPCParticipantStateMachine::State::unreachable };
-                    }
-                }
+                return;
             }
-            return std::move(states);
+            monitor_events->post([logger, participant_name, reachable]()
+            {
+                logger->notifyMonitor([&participant_name, reachable](IEventMonitor& monitor)
+                {
+                    monitor.onParticipantReachabilityChanged(participant_name, reachable);
+                });
+            });
         }
 
-        static System::State getAggregatedState(const PartStates& states)
+        ///state of one run of the health monitor, only used by one check at a time
+        struct HealthMonitor
         {
-            //we begin at the highest value
-            SystemAggregatedState aggregated_state = SystemAggregatedState::running;
-            //we have a look if at least one of it is set
-            bool first_set = false;
-            bool homogeneous_value = true;
-            for (const auto& item : states)
+            std::set<std::string> _unreachable;
+            std::chrono::milliseconds _min_interval;
+            std::chrono::milliseconds _max_interval;
+            ///interval until the next check
+            std::chrono::milliseconds _interval;
+        };
+
+        /**
+         * Probes every participant and reports the participants which became unreachable or reachable again.
+         * The interval until the next check is doubled (up to the maximum) after each check
+         * without a change and falls back to the minimum after a change.
+         * Runs within the timer thread of the worker pool (except the first one), so it must not block.
+         * The timers hold the lifetime lock while they use the system.
+         */
+        void checkHealth(uint64_t generation, const std::shared_ptr<HealthMonitor>& health_monitor)
+        {
+            if (generation != _health_generation)
+            {
+                return;
+            }
+            const auto participants = _state_mirror->getParticipants();
+            auto operation = std::make_shared<SystemOperation::Implementation>(_worker_pool,
+                participants,
+                "health check of system " + _system_name);
+            operation->setTraceName(_system_name, "healthCheck");
+            auto logger = _logger;
+            auto state_mirror = _state_mirror;
+            auto monitor_events = _monitor_events;
+            auto lifetime = _lifetime;
+            auto worker_pool = &_worker_pool;
+            const auto system_name = _system_name;
+            operation->addPhase(createProbePhase(participants, FEP_SYSTEM_DEFAULT_TIMEOUT,
+                [this, lifetime, worker_pool, generation, health_monitor, participants, logger, monitor_events, state_mirror, system_name](
+                    SystemOperation::Implementation&,
+                    const std::vector<bool>& reached)
             {
-                rpc::arya::IRPCParticipantStateMachine::State current_part_state = item.second;
-                //we were at least one times in this loop
-                if (current_part_state != rpc::arya::IRPCParticipantStateMachine::State::undefined)
+                bool changed = false;
+                std::set<std::string> unreachable;
+                for (size_t index = 0; index < participants.size(); ++index)
                 {
-                    if (current_part_state < aggregated_state)
+                    const auto& participant_name = participants[index].getName();
+                    const bool was_unreachable = health_monitor->_unreachable.count(participant_name) != 0;
+                    if (!reached[index])
                     {
-                        if (first_set)
+                        unreachable.insert(participant_name);
+                        if (!was_unreachable)
                         {
-                            //is not homogenous because some of the already checked states has an higher value
-                            homogeneous_value = false;
+                            changed = true;
+                            state_mirror->update(participant_name, System::AggregatedState::unreachable);
+                            logger->log(logging::Severity::error, "", system_name,
+                                "Participant " + participant_name + " of system " + system_name + " is unreachable");
+                            notifyReachability(logger, monitor_events, participant_name, false);
                         }
-                        aggregated_state = current_part_state;
                     }
-                    if (current_part_state > aggregated_state)
+                    else if (was_unreachable)
                     {
-                        //is not homogenous because some of the already checked states has an lower value
-                        homogeneous_value = false;
+                        changed = true;
+                        logger->log(logging::Severity::info, "", system_name,
+                            "Participant " + participant_name + " of system " + system_name + " is reachable again");
+                        notifyReachability(logger, monitor_events, participant_name, true);
                     }
                 }
-                //this is to check if this loop was already entered before we change 
-                first_set = true;
-            }
-            //no participant has a statemachine, then we are also undefined
-            if (!first_set) 
-            {
-                return { rpc::arya::IRPCParticipantStateMachine::State::undefined };
-            }
-            else
-            {
-                return { homogeneous_value , aggregated_state };
-            }
+                //removed participants are forgotten
+                health_monitor->_unreachable = std::move(unreachable);
+                if (changed)
+                {
+                    health_monitor->_interval = health_monitor->_min_interval;
+                }
+                const auto next_interval = health_monitor->_interval;
+                health_monitor->_interval = std::min(next_interval * 2, health_monitor->_max_interval);
+                //runs within a thread of the pool, which the pool joins before it is destroyed
+                worker_pool->postAt(std::chrono::steady_clock::now() + next_interval,
+                    [this, lifetime, generation, health_monitor]()
+                {
+                    std::lock_guard<std::mutex> lock(lifetime->_sync);
+                    if (!lifetime->_shut_down)
+                    {
+                        checkHealth(generation, health_monitor);
+                    }
+                });
+            }));
+            trackOperation(operation);
+            operation->start();
         }
 
-        System::State getSystemState(std::chrono::milliseconds timeout)
+        ///the pending reconciliation is not started anymore, a running one is finished
+        void stopReconciliation()
+        {
+            ++_reconciliation_generation;
+        }
+
+        /**
+         * Requests the states of all participants of the state mirror and schedules the next reconciliation.
+         * Runs within the timer thread of the worker pool (except the first one), so it must not block.
+         * The timers hold the lifetime lock while they use the system.
+         */
+        void reconcileStates(uint64_t generation, std::chrono::milliseconds reconciliation_interval)
         {
-            auto states = getParticipantStates(timeout);
-            return getAggregatedState(states);
+            if (generation != _reconciliation_generation)
+            {
+                return;
+            }
+            const auto state_machines = getStateMachineClients();
+            const auto request_time = std::chrono::steady_clock::now();
+            auto operation = std::make_shared<SystemOperation::Implementation>(_worker_pool,
+                state_machines->getParticipants(),
+                "reconciliation of the states of system " + _system_name);
+            operation->setTraceName(_system_name, "reconcileStates");
+            auto state_mirror = _state_mirror;
+            auto lifetime = _lifetime;
+            auto worker_pool = &_worker_pool;
+            operation->addPhase(createStateRequestPhase(state_machines, FEP_SYSTEM_DEFAULT_TIMEOUT,
+                [this, lifetime, worker_pool, state_machines, state_mirror, request_time, generation, reconciliation_interval](
+                    SystemOperation::Implementation&,
+                    const PartStates& states,
+                    const std::vector<bool>& answered)
+            {
+                state_mirror->reconcile(state_machines->getParticipants(), states, answered, request_time);
+                //runs within a thread of the pool, which the pool joins before it is destroyed
+                worker_pool->postAt(std::chrono::steady_clock::now() + reconciliation_interval,
+                    [this, lifetime, generation, reconciliation_interval]()
+                {
+                    std::lock_guard<std::mutex> lock(lifetime->_sync);
+                    if (!lifetime->_shut_down)
+                    {
+                        reconcileStates(generation, reconciliation_interval);
+                    }
+                });
+            }));
+            trackOperation(operation);
+            operation->start();
         }
 
         void registerMonitoring(IEventMonitor* monitor)
@@ -605,12 +2120,16 @@ namespace fep3
         void clear()
         {
             _participants.clear();
+            _priority_index.clear();
+            _state_mirror->clear();
+            resetStateMachineClients();
+            _latency_history->clear();
+            ++_timing_version;
         }
 
         void add(const std::string& participant_name, const std::string& participant_url)
         {
-            auto part_found = getParticipant(participant_name, false);
-            if (part_found)
+            if (_participants.find(participant_name))
             {
                 FEP3_SYSTEM_LOG_AND_THROW(_logger,
                     logging::Severity::fatal,
@@ -619,41 +2138,155 @@ namespace fep3
                     "Try to add a participant with name "
                     + participant_name + " which already exists.");
             }
-            _participants.push_back(ParticipantProxy(participant_name,
-                participant_url,
-                _system_name,
-                _system_discovery_url,
-                *_logger.get(),
-                PARTICIPANT_DEFAULT_TIMEOUT));
+            auto participant = createParticipantProxy(participant_name, participant_url);
+            _state_mirror->addParticipant(participant);
+            _priority_index.add(participant);
+            _participants.add(participant_name, std::move(participant));
+            resetStateMachineClients();
+            ++_timing_version;
         }
 
-        void remove(const std::string& participant_name)
+        /**
+         * Adds all @p participants (name and url) or none of them.
+         * The proxies connect to their participants concurrently (each connection is a handshake of several RPCs),
+         * the participants are added in the given order after every proxy was created.
+         */
+        void add(const std::vector<std::pair<std::string, std::string>>& participants)
         {
-            auto found = _participants.begin();
-            for (;
-                found != _participants.end();
-                ++found)
+            std::set<std::string> participant_names;
+            for (const auto& participant : participants)
             {
-                if (found->getName() == participant_name)
+                if (_participants.find(participant.first) || !participant_names.insert(participant.first).second)
                 {
-                    break;
+                    FEP3_SYSTEM_LOG_AND_THROW(_logger,
+                        logging::Severity::fatal,
+                        "",
+                        _system_name,
+                        "Try to add a participant with name "
+                        + participant.first + " which already exists.");
+                }
+            }
+            std::vector<std::future<ParticipantProxy>> created_participants;
+            created_participants.reserve(participants.size());
+            for (const auto& participant : participants)
+            {
+                //the system waits for every proxy below, so the worker may use it
+                created_participants.push_back(_worker_pool.submit([this, participant]()
+                {
+                    return createParticipantProxy(participant.first, participant.second);
+                }));
+            }
+            std::vector<ParticipantProxy> proxies;
+            std::vector<std::string> errors;
+            for (size_t index = 0; index < participants.size(); ++index)
+            {
+                try
+                {
+                    proxies.push_back(created_participants[index].get());
+                }
+                catch (const std::exception& ex)
+                {
+                    errors.push_back(participants[index].first + ": " + ex.what());
                 }
+                catch (...)
+                {
+                    errors.push_back(participants[index].first + ": unknown error");
+                }
+            }
+            if (!errors.empty())
+            {
+                FEP3_SYSTEM_LOG_AND_THROW(_logger,
+                    logging::Severity::fatal,
+                    "",
+                    _system_name,
+                    "None of the participants was added, the proxies of the following participants can not be created: "
+                    + join(errors, "; "));
             }
-            if (found != _participants.end())
+            for (size_t index = 0; index < participants.size(); ++index)
             {
-                _participants.erase(found);
+                _state_mirror->addParticipant(proxies[index]);
+                _priority_index.add(proxies[index]);
+                _participants.add(participants[index].first, std::move(proxies[index]));
             }
+            resetStateMachineClients();
+            ++_timing_version;
         }
 
-        ParticipantProxy getParticipant(const std::string& participant_name, bool throw_if_not_found) const
+        /**
+         * Adds the participants of @p other with proxies which share the connections of the proxies of @p other,
+         * so no request is sent (see ParticipantProxy::copyWithSharedConnection).
+         * The values of the proxies (i.e. the priorities) are copied.
+         * The participants log to the logger of the system which connected them, this logger is kept alive
+         * and forwards the logs to the logger of this system.
+         */
+        void addSharedParticipants(const Implementation& other)
         {
-            for (auto& part_found : _participants)
+            const auto participants = other._participants.getOrdered();
+            for (const auto& participant : participants)
+            {
+                if (_participants.find(participant.getName()))
+                {
+                    FEP3_SYSTEM_LOG_AND_THROW(_logger,
+                        logging::Severity::fatal,
+                        "",
+                        _system_name,
+                        "Try to add a participant with name "
+                        + participant.getName() + " which already exists.");
+                }
+            }
+            auto connection_loggers = other._connection_loggers;
+            connection_loggers.push_back(other._logger);
+            for (const auto& logger : connection_loggers)
             {
-                if (part_found.getName() == participant_name)
+                if (logger != _logger
+                    && std::find(_connection_loggers.begin(), _connection_loggers.end(), logger) == _connection_loggers.end())
                 {
-                    return part_found;
+                    logger->addLogForward(_logger);
+                    _connection_loggers.push_back(logger);
                 }
             }
+            for (const auto& participant : participants)
+            {
+                auto shared_participant = participant.copyWithSharedConnection();
+                _state_mirror->addParticipant(shared_participant);
+                _priority_index.add(shared_participant);
+                _participants.add(participant.getName(), std::move(shared_participant));
+            }
+            resetStateMachineClients();
+            ++_timing_version;
+        }
+
+        ParticipantProxy createParticipantProxy(const std::string& participant_name,
+            const std::string& participant_url) const
+        {
+            return ParticipantProxy(participant_name,
+                participant_url,
+                _system_name,
+                _system_discovery_url,
+                *_logger.get(),
+                PARTICIPANT_DEFAULT_TIMEOUT,
+                _lazy_connection);
+        }
+
+        void remove(const std::string& participant_name)
+        {
+            if (_participants.remove(participant_name))
+            {
+                _priority_index.remove();
+                _state_mirror->removeParticipant(participant_name);
+                resetStateMachineClients();
+                _latency_history->removeParticipant(participant_name);
+                ++_timing_version;
+            }
+        }
+
+        ParticipantProxy getParticipant(const std::string& participant_name, bool throw_if_not_found) const
+        {
+            const auto part_found = _participants.find(participant_name);
+            if (part_found)
+            {
+                return *part_found;
+            }
             if (throw_if_not_found)
             {
                 FEP3_SYSTEM_LOG_AND_THROW(_logger,
@@ -720,6 +2353,8 @@ namespace fep3
         {
             const auto property_normalized = replaceDotsWithSlashes(property_name);
             auto failing_participants = std::vector<std::string>();
+            ++_timing_version;
+            TraceScope trace_fan_out(SystemTracer::operation, "setProperty " + property_normalized, _system_name);
 
             for (const ParticipantProxy& participant : getParticipants())
             {
@@ -731,6 +2366,7 @@ namespace fep3
                     }
                 }
 
+				TraceScope trace_call(SystemTracer::call, "setProperty", _system_name, participant.getName());
 				try
 				{
 					auto config_rpc_client = participant.getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>();
@@ -741,8 +2377,10 @@ namespace fep3
 						if (!success)
 						{
 							failing_participants.push_back(participant.getName());
+							continue;
 						}
 					}
+					trace_call.setSuccessful();
 				}
 				catch (const std::exception& /*exception*/)
 				{
@@ -750,7 +2388,11 @@ namespace fep3
 				}
             }
 
-            if (!failing_participants.empty())
+            if (failing_participants.empty())
+            {
+				trace_fan_out.setSuccessful();
+            }
+            else
             {
 				const auto participants = join(failing_participants, ", ");
 				const auto message = format("property %s could not be set for the following participants: %s"
@@ -861,11 +2503,32 @@ namespace fep3
             return timing_masters_found;
         }
 
-        std::map<std::string, std::unique_ptr<IProperties>> getTimingProperties() const
+        ///timing properties by participant name, shared by coalesced queries
+        using TimingProperties = std::map<std::string, std::unique_ptr<IProperties>>;
+
+        TimingProperties getTimingProperties()
+        {
+            auto shared_properties = _timing_properties_queries.get(0, [this]()
+            {
+                return std::shared_ptr<const TimingProperties>(new TimingProperties(requestTimingProperties()));
+            });
+            TimingProperties timing_properties;
+            for (const auto& participant_properties : *shared_properties)
+            {
+                std::unique_ptr<IProperties> properties(new Properties<IProperties>());
+                participant_properties.second->copy_to(*properties);
+                timing_properties.emplace(participant_properties.first, std::move(properties));
+            }
+            return timing_properties;
+        }
+
+        TimingProperties requestTimingProperties() const
         {
-            std::map<std::string, std::unique_ptr<IProperties>> timing_properties;
+            TimingProperties timing_properties;
+            TraceScope trace_fan_out(SystemTracer::operation, "getTimingProperties", _system_name);
             for (const ParticipantProxy& participant : getParticipants())
             {
+                TraceScope trace_call(SystemTracer::call, "getTimingProperties", _system_name, participant.getName());
                 auto iterator_success = timing_properties.emplace(participant.getName(),
                     std::unique_ptr<IProperties>(new Properties<IProperties>()));
                 if (!iterator_success.second)
@@ -909,16 +2572,73 @@ namespace fep3
                 {
                     set_if_present(*scheduler_props, FEP3_SCHEDULER_PROPERTY);
                 }
+                trace_call.setSuccessful();
             }
+            trace_fan_out.setSuccessful();
             return timing_properties;
         }
 
         //mutable std::mutex _system_mutex;
-        std::vector<ParticipantProxy> _participants;
+        ///the loggers the shared connections of the participants log to (see addSharedParticipants), they must outlive the participants
+        std::vector<std::shared_ptr<SystemLogger>> _connection_loggers;
+        ParticipantRegistry _participants;
+        ///the priority levels of _participants for the transitions
+        PriorityIndex _priority_index;
         std::shared_ptr<SystemLogger> _logger = std::make_shared<SystemLogger>();
         std::string _system_name;
         std::string _system_discovery_url;
         std::shared_ptr<arya::IServiceBusConnection> _service_bus_connection;
+        std::vector<std::weak_ptr<SystemOperation::Implementation>> _operations;
+        std::mutex _sync_operations;
+        size_t _shutdown_concurrency{ FEP_SYSTEM_SHUTDOWN_CONCURRENCY };
+        bool _preflight_check{ false };
+        std::chrono::milliseconds _preflight_timeout{ FEP_SYSTEM_DEFAULT_TIMEOUT };
+        bool _idempotent_transitions{ false };
+        bool _lazy_connection{ false };
+        size_t _host_concurrency{ 0 };
+        std::shared_ptr<SystemStateMirror> _state_mirror = std::make_shared<SystemStateMirror>();
+        ///state machine clients of all participants for the state requests, created at the first one
+        std::shared_ptr<StateMachineClients> _state_machines;
+        std::mutex _sync_state_machines;
+        std::shared_ptr<LatencyHistory> _latency_history = std::make_shared<LatencyHistory>(FEP_SYSTEM_LATENCY_HISTORY_SIZE);
+        ///the latencies of the adaptive timeouts, not cleared with _latency_history (see getLearnedLatencies)
+        std::shared_ptr<LatencyHistory> _learned_latencies;
+        bool _adaptive_timeouts{ false };
+        double _adaptive_timeout_factor{ FEP_SYSTEM_ADAPTIVE_TIMEOUT_FACTOR };
+        std::chrono::milliseconds _adaptive_timeout_floor{ FEP_SYSTEM_ADAPTIVE_TIMEOUT_FLOOR };
+        std::chrono::milliseconds _adaptive_timeout_ceiling{ FEP_SYSTEM_ADAPTIVE_TIMEOUT_CEILING };
+        ///read by every getSystemState, which may be called from any thread
+        std::atomic<bool> _state_mirror_enabled{ false };
+        std::chrono::milliseconds _reconciliation_interval{ FEP_SYSTEM_STATE_RECONCILIATION_INTERVAL };
+        std::atomic<std::chrono::milliseconds::rep> _max_state_staleness{ FEP_SYSTEM_STATE_MIRROR_MAX_STALENESS.count() };
+        std::atomic<uint64_t> _reconciliation_generation{ 0 };
+        bool _health_monitor_enabled{ false };
+        std::chrono::milliseconds _health_min_interval{ FEP_SYSTEM_HEALTH_CHECK_MIN_INTERVAL };
+        std::chrono::milliseconds _health_max_interval{ FEP_SYSTEM_HEALTH_CHECK_MAX_INTERVAL };
+        std::atomic<uint64_t> _health_generation{ 0 };
+        ///changed by every change of the participants or of their properties
+        mutable std::atomic<uint64_t> _timing_version{ 0 };
+        ///a cached system state is valid until the state mirror learns a change
+        SingleFlight<std::chrono::milliseconds::rep, System::State> _system_state_queries{
+            [this]() { return _state_mirror->getVersion(); } };
+        SingleFlight<int, std::shared_ptr<const TimingProperties>> _timing_properties_queries{
+            [this]() { return _timing_version.load(); } };
+        ///delivers the progress events to the monitor in order (see TransitionProgressReporter)
+        std::shared_ptr<WorkerPool> _monitor_events = std::make_shared<WorkerPool>(1);
+        /**
+         * Guards the use of the system by the timers of the background operations, which may fire after its
+         * destruction began. The destruction sets _shut_down under the lock, so it waits for a running timer
+         * and the later ones neither use the system nor start operations which would not be cancelled.
+         */
+        struct Lifetime
+        {
+            std::mutex _sync;
+            bool _shut_down = false;
+        };
+        ///shared with the timers and the background operations (see checkHealth and reconcileStates)
+        std::shared_ptr<Lifetime> _lifetime = std::make_shared<Lifetime>();
+        //the pool must be the first to be destroyed, it waits for the running calls
+        WorkerPool _worker_pool{ max_worker_count };
     };
 
     System::System() : _impl(new Implementation(""))
@@ -938,25 +2658,23 @@ namespace fep3
     System::System(const System& other) : _impl(new Implementation(other.getSystemName(),
           other.getSystemUrl()))
     {
-        auto proxies = other.getParticipants();
-        for (const auto& proxy : proxies)
-        {
-            _impl->add(proxy.getName(), proxy.getUrl());
-            auto new_proxy = _impl->getParticipant(proxy.getName(), true);
-            proxy.copyValuesTo(new_proxy);
-        }
+        _impl->setLazyConnection(other.getLazyConnection());
+        _impl->addSharedParticipants(*other._impl);
+        _impl->copySettingsFrom(*other._impl);
     }
 
     System& System::operator=(const System& other)
     {
-        _impl->_system_name = getSystemName();
-        auto proxies = other.getParticipants();
-        for (const auto& proxy : proxies)
+        if (this == &other)
         {
-            _impl->add(proxy.getName(), proxy.getUrl());
-            auto new_proxy = _impl->getParticipant(proxy.getName(), true);
-            proxy.copyValuesTo(new_proxy);
+            return *this;
         }
+        _impl->_system_name = getSystemName();
+        _impl->setLazyConnection(other.getLazyConnection());
+        //the participants of this system are replaced by the ones of the other
+        _impl->clear();
+        _impl->addSharedParticipants(*other._impl);
+        _impl->copySettingsFrom(*other._impl);
         return *this;
     }
 
@@ -975,48 +2693,234 @@ namespace fep3
     {
     }
 
+    void System::setShutdownConcurrency(size_t max_concurrent_participants)
+    {
+        _impl->setShutdownConcurrency(max_concurrent_participants);
+    }
+
+    size_t System::getShutdownConcurrency() const
+    {
+        return _impl->getShutdownConcurrency();
+    }
+
+    void System::setPreflightCheck(bool enable, std::chrono::milliseconds timeout)
+    {
+        _impl->setPreflightCheck(enable, timeout);
+    }
+
+    bool System::getPreflightCheck() const
+    {
+        return _impl->getPreflightCheck();
+    }
+
+    void System::setHostConcurrency(size_t max_concurrent_participants)
+    {
+        _impl->setHostConcurrency(max_concurrent_participants);
+    }
+
+    size_t System::getHostConcurrency() const
+    {
+        return _impl->getHostConcurrency();
+    }
+
+    void System::setIdempotentTransitions(bool enable)
+    {
+        _impl->setIdempotentTransitions(enable);
+    }
+
+    bool System::getIdempotentTransitions() const
+    {
+        return _impl->getIdempotentTransitions();
+    }
+
+    void System::setStateMirror(bool enable,
+        std::chrono::milliseconds reconciliation_interval,
+        std::chrono::milliseconds max_staleness)
+    {
+        _impl->setStateMirror(enable, reconciliation_interval, max_staleness);
+    }
+
+    bool System::getStateMirror() const
+    {
+        return _impl->getStateMirror();
+    }
+
+    std::chrono::milliseconds System::getStateStaleness() const
+    {
+        return _impl->getStateStaleness();
+    }
+
+    void System::setHealthMonitor(bool enable,
+        std::chrono::milliseconds min_interval,
+        std::chrono::milliseconds max_interval)
+    {
+        _impl->setHealthMonitor(enable, min_interval, max_interval);
+    }
+
+    bool System::getHealthMonitor() const
+    {
+        return _impl->getHealthMonitor();
+    }
+
+    void System::setQueryCache(std::chrono::milliseconds max_age)
+    {
+        _impl->setQueryCache(max_age);
+    }
+
+    std::chrono::milliseconds System::getQueryCache() const
+    {
+        return _impl->getQueryCache();
+    }
+
+    TransitionLatencies System::getTransitionLatencies(const std::string& transition, size_t slowest_count) const
+    {
+        return _impl->getTransitionLatencies(transition, slowest_count);
+    }
+
+    void System::clearTransitionLatencies()
+    {
+        _impl->clearTransitionLatencies();
+    }
+
+    void System::setAdaptiveTimeouts(bool enable,
+        double factor,
+        std::chrono::milliseconds floor,
+        std::chrono::milliseconds ceiling)
+    {
+        _impl->setAdaptiveTimeouts(enable, factor, floor, ceiling);
+    }
+
+    bool System::getAdaptiveTimeouts() const
+    {
+        return _impl->getAdaptiveTimeouts();
+    }
+
+    std::chrono::milliseconds System::getAdaptiveTimeout(const std::string& participant_name,
+        const std::string& transition) const
+    {
+        return _impl->getAdaptiveTimeout(participant_name, transition);
+    }
+
+    void System::setLazyConnection(bool enable)
+    {
+        _impl->setLazyConnection(enable);
+    }
+
+    bool System::getLazyConnection() const
+    {
+        return _impl->getLazyConnection();
+    }
+
+    bool System::waitForSystemState(System::AggregatedState state, std::chrono::milliseconds timeout) const
+    {
+        return _impl->waitForSystemState(state, timeout);
+    }
+
+    bool System::waitForParticipantState(const std::string& participant_name,
+        System::AggregatedState state,
+        std::chrono::milliseconds timeout) const
+    {
+        return _impl->waitForParticipantState(participant_name, state, timeout);
+    }
+
     void System::setSystemState(System::AggregatedState state, std::chrono::milliseconds timeout) const
     {
-        _impl->setSystemState(state, timeout);
+        _impl->setSystemState(state, timeout).get();
     }
 
     void System::load(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
     {
-        _impl->load(timeout);
+        _impl->load(timeout).get();
     }
 
     void System::unload(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
     {
-        _impl->unload(timeout);
+        _impl->unload(timeout).get();
     }
 
     void System::initialize(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
     {
-        _impl->initialize(timeout);
+        _impl->initialize(timeout).get();
     }
     void System::deinitialize(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
     {
-        _impl->deinitialize(timeout);
+        _impl->deinitialize(timeout).get();
     }
 
     void System::start(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
     {
-        _impl->start(timeout);
+        _impl->start(timeout).get();
     }
 
     void System::stop(std::chrono::milliseconds timeout/*= FEP_SYSTEM_TRANSITION_TIME*/) const
     {
-        _impl->stop(timeout);
+        _impl->stop(timeout).get();
     }
 
     void System::pause(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
     {
-        _impl->pause(timeout);
+        _impl->pause(timeout).get();
     }
 
     void System::shutdown(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
     {
-        _impl->shutdown(timeout);
+        _impl->shutdown(timeout).get();
+    }
+
+    SystemOperation System::setSystemStateAsync(System::AggregatedState state, std::chrono::milliseconds timeout) const
+    {
+        return _impl->setSystemState(state, timeout);
+    }
+
+    void System::convergeSystemState(System::AggregatedState state, std::chrono::milliseconds timeout) const
+    {
+        _impl->convergeSystemState(state, timeout).get();
+    }
+
+    SystemOperation System::convergeSystemStateAsync(System::AggregatedState state,
+        std::chrono::milliseconds timeout) const
+    {
+        return _impl->convergeSystemState(state, timeout);
+    }
+
+    SystemOperation System::loadAsync(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
+    {
+        return _impl->load(timeout);
+    }
+
+    SystemOperation System::unloadAsync(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
+    {
+        return _impl->unload(timeout);
+    }
+
+    SystemOperation System::initializeAsync(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
+    {
+        return _impl->initialize(timeout);
+    }
+
+    SystemOperation System::deinitializeAsync(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
+    {
+        return _impl->deinitialize(timeout);
+    }
+
+    SystemOperation System::startAsync(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
+    {
+        return _impl->start(timeout);
+    }
+
+    SystemOperation System::stopAsync(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
+    {
+        return _impl->stop(timeout);
+    }
+
+    SystemOperation System::pauseAsync(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
+    {
+        return _impl->pause(timeout);
+    }
+
+    SystemOperation System::shutdownAsync(std::chrono::milliseconds timeout /*= FEP_SYSTEM_TRANSITION_TIME*/) const
+    {
+        return _impl->shutdown(timeout);
     }
     
 
@@ -1027,18 +2931,17 @@ namespace fep3
 
     void System::add(const std::vector<std::string>& participants)
     {
+        std::vector<std::pair<std::string, std::string>> participants_with_url;
         for (const auto& participant : participants)
         {
-            _impl->add(participant, std::string());
+            participants_with_url.emplace_back(participant, std::string());
         }
+        _impl->add(participants_with_url);
     }
 
     void System::add(const std::multimap<std::string, std::string>& participants)
     {
-        for (const auto& participant : participants)
-        {
-            _impl->add(participant.first, participant.second);
-        }
+        _impl->add(std::vector<std::pair<std::string, std::string>>(participants.begin(), participants.end()));
     }
 
     void System::remove(const std::string& participant)
@@ -1160,6 +3063,36 @@ namespace fep3
             master_element_id, master_time_stepsize, "0.0", "");
     }
 
+/**************************************************************
+* tracing
+***************************************************************/
+
+    void startTracing(size_t max_event_count /*= FEP_SYSTEM_TRACE_MAX_EVENTS*/)
+    {
+        SystemTracer::get().start(max_event_count);
+    }
+
+    void stopTracing()
+    {
+        SystemTracer::get().stop();
+    }
+
+    std::string getTrace()
+    {
+        return SystemTracer::get().getJson();
+    }
+
+    void writeTrace(const std::string& file_path)
+    {
+        std::ofstream trace_file(file_path, std::ios::out | std::ios::trunc);
+        trace_file << getTrace();
+        trace_file.close();
+        if (!trace_file)
+        {
+            throw std::runtime_error("can not write the trace to '" + file_path + "'");
+        }
+    }
+
 /**************************************************************
 * discoveries 
 ***************************************************************/
@@ -1184,12 +3117,11 @@ namespace fep3
                 throw std::runtime_error("can not find a system access on service bus connection to system '"
                     + name + "' at url '" + discover_url);
             }
+            TraceScope trace_discovery(SystemTracer::operation, "discoverSystem", name);
             auto participants = sys_access->discover(timeout);
+            trace_discovery.setSuccessful();
             System discovered_system(name, discover_url);
-            for (auto& part : participants)
-            {
-                discovered_system.add(part.first, part.second);
-            }
+            discovered_system.add(std::multimap<std::string, std::string>(participants.begin(), participants.end()));
             return std::move(discovered_system);
         }
         throw std::runtime_error("can not create a service bus connection to system '"
@@ -1219,24 +3151,18 @@ namespace fep3
                 throw std::runtime_error("can not create a system access on service bus connection to discover all systems at url '"
                     + discover_url);
             }
-            std::map<std::string, std::unique_ptr<System>> all_systems_map;
+            //the participants of each system are added at once, so their proxies are created concurrently
+            std::map<std::string, std::multimap<std::string, std::string>> participants_by_system;
 
+            TraceScope trace_discovery(SystemTracer::operation, "discoverAllSystems", std::string());
             auto all_participants = sys_access->discover(timeout);
+            trace_discovery.setSuccessful();
             for (auto& part : all_participants)
             {
                 auto splitted_id =  a_util::strings::split(part.first, "@", true);
-                if (splitted_id.size() > 0)
+                if (splitted_id.size() > 1)
                 {
-                    auto existing_system = all_systems_map.find(splitted_id[1]);
-                    if (existing_system != all_systems_map.end())
-                    {
-                        existing_system->second->add(splitted_id[0], part.second);
-                    }
-                    else
-                    {
-                        all_systems_map[splitted_id[1]] = std::make_unique<System>(splitted_id[1]);
-                        all_systems_map[splitted_id[1]]->add(splitted_id[0], part.second);
-                    }
+                    participants_by_system[splitted_id[1]].emplace(splitted_id[0], part.second);
                 }
                 else
                 {
@@ -1244,9 +3170,11 @@ namespace fep3
                 }
             }
             std::vector<System> result_vector_system;
-            for (auto& found_sys : all_systems_map)
+            result_vector_system.reserve(participants_by_system.size());
+            for (const auto& system_participants : participants_by_system)
             {
-                result_vector_system.emplace_back(std::move(*found_sys.second.release()));
+                result_vector_system.emplace_back(system_participants.first);
+                result_vector_system.back().add(system_participants.second);
             }
 
             return std::move(result_vector_system);
@@ -0,0 +1,187 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+#pragma once
+#include <fep_system/fep_system.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fep3
+{
+    /**
+     * @brief Durations of the latest calls by call name (i.e. "start") and participant.
+     * The history is bounded: only the latest @p capacity calls of each participant and call name are kept.
+     * Calls are recorded from the worker threads of the system, so every method is thread safe.
+     */
+    class LatencyHistory
+    {
+    public:
+        using Duration = std::chrono::steady_clock::duration;
+
+        explicit LatencyHistory(size_t capacity) : _capacity(std::max<size_t>(capacity, 1))
+        {
+        }
+
+        LatencyHistory(const LatencyHistory&) = delete;
+        LatencyHistory& operator=(const LatencyHistory&) = delete;
+
+        void record(const std::string& call_name, const std::string& participant_name, Duration duration)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            auto& samples = _samples[call_name][participant_name];
+            if (samples._durations.size() < _capacity)
+            {
+                samples._durations.push_back(duration);
+            }
+            else
+            {
+                samples._durations[samples._next] = duration;
+            }
+            samples._next = (samples._next + 1) % _capacity;
+        }
+
+        void removeParticipant(const std::string& participant_name)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            for (auto& call : _samples)
+            {
+                call.second.erase(participant_name);
+            }
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            _samples.clear();
+        }
+
+        /**
+         * Gets the percentiles of all recorded calls of @p call_name and the @p slowest_count participants
+         * with the highest 90th percentile.
+         */
+        TransitionLatencies getLatencies(const std::string& call_name, size_t slowest_count) const
+        {
+            TransitionLatencies latencies;
+            std::vector<Duration> all_durations;
+            {
+                std::lock_guard<std::mutex> lock(_sync);
+                auto call = _samples.find(call_name);
+                if (call == _samples.end())
+                {
+                    return latencies;
+                }
+                for (const auto& participant : call->second)
+                {
+                    auto durations = participant.second._durations;
+                    all_durations.insert(all_durations.end(), durations.begin(), durations.end());
+                    std::sort(durations.begin(), durations.end());
+                    TransitionLatencies::Participant participant_latencies;
+                    participant_latencies._participant_name = participant.first;
+                    setPercentiles(durations, participant_latencies);
+                    latencies._slowest.push_back(std::move(participant_latencies));
+                }
+            }
+            std::sort(all_durations.begin(), all_durations.end());
+            setPercentiles(all_durations, latencies);
+            std::stable_sort(latencies._slowest.begin(), latencies._slowest.end(),
+                [](const TransitionLatencies::Participant& first, const TransitionLatencies::Participant& second)
+                {
+                    return first._p90 > second._p90;
+                });
+            if (latencies._slowest.size() > slowest_count)
+            {
+                latencies._slowest.resize(slowest_count);
+            }
+            return latencies;
+        }
+
+        /**
+         * Gets the nearest rank percentile @p percentile (0.0 to 1.0) of the recorded calls of one participant.
+         *
+         * @return false if less than @p min_count calls (at least one) of the participant are recorded
+         *         (@p duration is not set)
+         */
+        bool getPercentile(const std::string& call_name,
+            const std::string& participant_name,
+            double percentile,
+            size_t min_count,
+            Duration& duration) const
+        {
+            std::vector<Duration> durations;
+            {
+                std::lock_guard<std::mutex> lock(_sync);
+                auto call = _samples.find(call_name);
+                if (call == _samples.end())
+                {
+                    return false;
+                }
+                auto participant = call->second.find(participant_name);
+                if (participant == call->second.end()
+                    || participant->second._durations.size() < std::max<size_t>(min_count, 1))
+                {
+                    return false;
+                }
+                durations = participant->second._durations;
+            }
+            std::sort(durations.begin(), durations.end());
+            duration = getPercentile(durations, percentile);
+            return true;
+        }
+
+    private:
+        struct Samples
+        {
+            ///ring buffer of the latest durations
+            std::vector<Duration> _durations;
+            size_t _next = 0;
+        };
+
+        static Duration getPercentile(const std::vector<Duration>& sorted_durations, double percentile)
+        {
+            const auto rank = static_cast<size_t>(std::ceil(percentile * sorted_durations.size()));
+            return sorted_durations[std::min(std::max<size_t>(rank, 1), sorted_durations.size()) - 1];
+        }
+
+        template<typename Latencies>
+        static void setPercentiles(const std::vector<Duration>& sorted_durations, Latencies& latencies)
+        {
+            latencies._count = sorted_durations.size();
+            if (sorted_durations.empty())
+            {
+                return;
+            }
+            latencies._p50 = std::chrono::duration_cast<std::chrono::microseconds>(getPercentile(sorted_durations, 0.5));
+            latencies._p90 = std::chrono::duration_cast<std::chrono::microseconds>(getPercentile(sorted_durations, 0.9));
+            latencies._p99 = std::chrono::duration_cast<std::chrono::microseconds>(getPercentile(sorted_durations, 0.99));
+            latencies._max = std::chrono::duration_cast<std::chrono::microseconds>(sorted_durations.back());
+        }
+
+        const size_t _capacity;
+        ///samples by call name and participant name
+        std::map<std::string, std::map<std::string, Samples>> _samples;
+        mutable std::mutex _sync;
+    };
+}
@@ -33,14 +33,16 @@ ParticipantProxy::ParticipantProxy(const std::string& participant_name,
     const std::string& system_name,
     const std::string& system_discovery_url,
     ISystemLogger& logger,
-    std::chrono::milliseconds default_timeout)
+    std::chrono::milliseconds default_timeout,
+    bool lazy_connection)
 {
     _impl.reset(new Implementation(participant_name,
                                    participant_url,
                                    system_name,
                                    system_discovery_url,
                                    logger,
-                                   default_timeout));
+                                   default_timeout,
+                                   lazy_connection));
 }
 ParticipantProxy::ParticipantProxy(ParticipantProxy&& other)
 {
@@ -68,6 +70,16 @@ void ParticipantProxy::copyValuesTo(ParticipantProxy& other) const
     _impl->copyValuesTo(*(other._impl));
 }
 
+ParticipantProxy ParticipantProxy::copyWithSharedConnection() const
+{
+    ParticipantProxy copied;
+    if (_impl)
+    {
+        copied._impl = std::make_shared<Implementation>(*_impl);
+    }
+    return copied;
+}
+
 void ParticipantProxy::setInitPriority(int32_t priority)
 {
     _impl->setInitPriority(priority);
@@ -88,6 +100,26 @@ int32_t ParticipantProxy::getStartPriority() const
     return _impl->getStartPriority();
 }
 
+void ParticipantProxy::setInitDependencies(const std::vector<std::string>& participant_names)
+{
+    _impl->setInitDependencies(participant_names);
+}
+
+std::vector<std::string> ParticipantProxy::getInitDependencies() const
+{
+    return _impl->getInitDependencies();
+}
+
+void ParticipantProxy::setStartDependencies(const std::vector<std::string>& participant_names)
+{
+    _impl->setStartDependencies(participant_names);
+}
+
+std::vector<std::string> ParticipantProxy::getStartDependencies() const
+{
+    return _impl->getStartDependencies();
+}
+
 std::string ParticipantProxy::getName() const
 {
     return _impl->getParticipantName();
@@ -0,0 +1,140 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+
+#pragma once
+#include <fep_system/participant_proxy.h>
+
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fep3
+{
+    /**
+     * @brief The participants of a system by name, in order of their addition.
+     * Adding, finding and removing a participant is constant time (average), the ordered list
+     * of all participants is rebuilt at its first use after a change.
+     * Like fep3::System the registry must not be changed concurrently, reading it concurrently is fine.
+     */
+    class ParticipantRegistry
+    {
+    public:
+        ParticipantRegistry() = default;
+
+        ParticipantRegistry(const ParticipantRegistry&) = delete;
+        ParticipantRegistry& operator=(const ParticipantRegistry&) = delete;
+
+        ParticipantRegistry& operator=(ParticipantRegistry&& other)
+        {
+            //the iterators of the index stay valid, the nodes of the list are moved as a whole
+            _participants = std::move(other._participants);
+            _index = std::move(other._index);
+            invalidateOrdered();
+            other.clear();
+            return *this;
+        }
+
+        /**
+         * Adds @p participant as @p participant_name.
+         *
+         * @return false if a participant with this name is already added (it is not replaced)
+         */
+        bool add(const std::string& participant_name, ParticipantProxy participant)
+        {
+            if (_index.find(participant_name) != _index.end())
+            {
+                return false;
+            }
+            _participants.push_back(std::move(participant));
+            _index.emplace(participant_name, std::prev(_participants.end()));
+            invalidateOrdered();
+            return true;
+        }
+
+        ///@return false if there is no participant with this name
+        bool remove(const std::string& participant_name)
+        {
+            const auto found = _index.find(participant_name);
+            if (found == _index.end())
+            {
+                return false;
+            }
+            _participants.erase(found->second);
+            _index.erase(found);
+            invalidateOrdered();
+            return true;
+        }
+
+        void clear()
+        {
+            _participants.clear();
+            _index.clear();
+            invalidateOrdered();
+        }
+
+        ///@return the participant, nullptr if there is none with this name
+        const ParticipantProxy* find(const std::string& participant_name) const
+        {
+            const auto found = _index.find(participant_name);
+            return (found == _index.end()) ? nullptr : &*found->second;
+        }
+
+        size_t size() const
+        {
+            return _participants.size();
+        }
+
+        bool empty() const
+        {
+            return _participants.empty();
+        }
+
+        ///the participants in order of their addition, the reference is valid until the next change
+        const std::vector<ParticipantProxy>& getOrdered() const
+        {
+            std::lock_guard<std::mutex> lock(_sync_ordered);
+            if (!_ordered_valid)
+            {
+                _ordered.assign(_participants.begin(), _participants.end());
+                _ordered_valid = true;
+            }
+            return _ordered;
+        }
+
+    private:
+        ///drops the copies of the proxies at once, so a removed participant is not kept alive by them
+        void invalidateOrdered()
+        {
+            std::lock_guard<std::mutex> lock(_sync_ordered);
+            _ordered.clear();
+            _ordered_valid = false;
+        }
+
+        std::list<ParticipantProxy> _participants;
+        std::unordered_map<std::string, std::list<ParticipantProxy>::iterator> _index;
+        mutable std::vector<ParticipantProxy> _ordered;
+        mutable bool _ordered_valid{ true };
+        mutable std::mutex _sync_ordered;
+    };
+}
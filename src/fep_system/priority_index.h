@@ -0,0 +1,205 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+#pragma once
+#include <fep_system/participant_proxy.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace fep3
+{
+    /**
+     * @brief The init and start priority levels of the participants of a system, maintained incrementally.
+     * The levels hold the indexes of the participants within the ordered participants of the system
+     * (see ParticipantRegistry::getOrdered).
+     * An added participant is sorted into its levels, a participant whose priority was changed at its proxy
+     * is moved to its new level at the next use. Only a removal renumbers the participants, so the levels are
+     * rebuilt at the next use after it.
+     * The levels handed out are shared and never changed, a transition iterates them without copying.
+     *
+     * The order within one level is deterministic: for load, initialize, start and pause (@p reverse_prio)
+     * the highest priority comes first and the participants of one level are in the order they were added,
+     * for unload, deinitialize and stop the lowest priority comes first and the participants of one level
+     * are in the reverse order.
+     */
+    class PriorityIndex
+    {
+    public:
+        using Levels = std::vector<std::vector<size_t>>;
+
+        PriorityIndex() = default;
+
+        PriorityIndex(const PriorityIndex&) = delete;
+        PriorityIndex& operator=(const PriorityIndex&) = delete;
+
+        ///adds @p participant, it must be the last of the ordered participants
+        void add(const ParticipantProxy& participant)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            if (_rebuild)
+            {
+                return;
+            }
+            for (bool init_false_start_true : { false, true })
+            {
+                auto& order = _orders[init_false_start_true];
+                const auto index = order._priorities.size();
+                const auto priority = getPriority(participant, init_false_start_true);
+                order._priorities.push_back(priority);
+                order._levels[priority].push_back(index);
+                order.invalidate();
+            }
+        }
+
+        ///the participants after the removed one are renumbered, the levels are rebuilt at the next use
+        void remove()
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            _rebuild = true;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            for (auto& order : _orders)
+            {
+                order = Order();
+            }
+            _rebuild = false;
+        }
+
+        /**
+         * Gets the init (or start) priority levels of @p participants, which are the ordered participants
+         * this index was maintained for.
+         * The levels are created only if a participant was added, removed or its priority changed since the last call.
+         */
+        std::shared_ptr<const Levels> getLevels(const std::vector<ParticipantProxy>& participants,
+            bool init_false_start_true,
+            bool reverse_prio)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            if (_rebuild || _orders[init_false_start_true]._priorities.size() != participants.size())
+            {
+                rebuild(participants);
+            }
+            auto& order = _orders[init_false_start_true];
+            for (size_t index = 0; index < participants.size(); ++index)
+            {
+                const auto priority = getPriority(participants[index], init_false_start_true);
+                if (priority != order._priorities[index])
+                {
+                    order.move(index, priority);
+                }
+            }
+            auto& levels = order._cached_levels[reverse_prio];
+            if (!levels)
+            {
+                levels = order.createLevels(reverse_prio);
+            }
+            return levels;
+        }
+
+    private:
+        struct Order
+        {
+            ///priority by participant index
+            std::vector<int32_t> _priorities;
+            ///participant indexes by priority, ascending within each level
+            std::map<int32_t, std::vector<size_t>> _levels;
+            ///the levels handed out, by reverse_prio
+            std::shared_ptr<const Levels> _cached_levels[2];
+
+            void invalidate()
+            {
+                _cached_levels[0].reset();
+                _cached_levels[1].reset();
+            }
+
+            void move(size_t index, int32_t priority)
+            {
+                auto old_level = _levels.find(_priorities[index]);
+                auto& old_indexes = old_level->second;
+                old_indexes.erase(std::lower_bound(old_indexes.begin(), old_indexes.end(), index));
+                if (old_indexes.empty())
+                {
+                    _levels.erase(old_level);
+                }
+                auto& new_indexes = _levels[priority];
+                new_indexes.insert(std::lower_bound(new_indexes.begin(), new_indexes.end(), index), index);
+                _priorities[index] = priority;
+                invalidate();
+            }
+
+            std::shared_ptr<const Levels> createLevels(bool reverse_prio) const
+            {
+                auto levels = std::make_shared<Levels>();
+                levels->reserve(_levels.size());
+                if (reverse_prio)
+                {
+                    //reverse order of prio, normal order of parts having the same prio
+                    for (auto current_prio = _levels.rbegin(); current_prio != _levels.rend(); ++current_prio)
+                    {
+                        levels->push_back(current_prio->second);
+                    }
+                }
+                else
+                {
+                    //normal order of prio, reverse order of parts having the same prio
+                    for (const auto& current_prio : _levels)
+                    {
+                        levels->emplace_back(current_prio.second.rbegin(), current_prio.second.rend());
+                    }
+                }
+                return levels;
+            }
+        };
+
+        static int32_t getPriority(const ParticipantProxy& participant, bool init_false_start_true)
+        {
+            return init_false_start_true ? participant.getStartPriority() : participant.getInitPriority();
+        }
+
+        void rebuild(const std::vector<ParticipantProxy>& participants)
+        {
+            for (bool init_false_start_true : { false, true })
+            {
+                auto& order = _orders[init_false_start_true];
+                order = Order();
+                for (size_t index = 0; index < participants.size(); ++index)
+                {
+                    const auto priority = getPriority(participants[index], init_false_start_true);
+                    order._priorities.push_back(priority);
+                    order._levels[priority].push_back(index);
+                }
+            }
+            _rebuild = false;
+        }
+
+        ///by init_false_start_true
+        Order _orders[2];
+        bool _rebuild = false;
+        std::mutex _sync;
+    };
+}
@@ -19,7 +19,9 @@
  */
 
 #pragma once
+#include <atomic>
 #include <string>
+#include <mutex>
 #include "system_logger_intf.h"
 
 #include "rpc_services/participant_info_proxy.hpp"
@@ -34,7 +36,13 @@
 namespace fep3
 {
 
-struct ParticipantProxy::Implementation
+/**
+ * The connection to one participant: the RPC components found at the participant and the registration
+ * of the logging sink of the system at the participant.
+ * It is shared by all proxies copied by ParticipantProxy::copyWithSharedConnection (i.e. by the copies of a system),
+ * the logging sink is unregistered when the last of them is destroyed.
+ */
+class ParticipantConnection
 {
 public:
     //this is the current type used within connect() 
@@ -49,16 +57,28 @@ public:
     {
     public:
         typedef T value_type;
-        RPCComponentCache(ParticipantProxy::Implementation* proxy_impl) : _proxy_impl(proxy_impl)
+        RPCComponentCache(ParticipantConnection* connection) : _connection(connection)
         {
         }
         RPCComponent<T> getValue()
         {
-            if (!_value)
+            RPCComponent<T> value;
+            bool connected = false;
+            {
+                //the system calls the participants from several threads
+                std::lock_guard<std::recursive_mutex> lock(_sync);
+                if (!_value)
+                {
+                    _value = connect();
+                    connected = static_cast<bool>(_value);
+                }
+                value = _value;
+            }
+            if (connected)
             {
-                _value = connect();
+                _connection->onComponentConnected();
             }
-            return _value;
+            return value;
         }
         RPCComponent<T> connect()
         {
@@ -67,7 +87,7 @@ public:
                 //it is very important to use arya here ... 
                 //because we support versioning !! 
                 RPCComponent<T> val;
-                if (_proxy_impl->getRPCComponentProxy(T::getRPCDefaultName(),
+                if (_connection->getRPCComponentProxy(T::getRPCDefaultName(),
                     T::getRPCIID(),
                     val))
                 {
@@ -85,11 +105,13 @@ public:
         }
         bool hasValue() const
         {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
             return static_cast<bool>(_value);
         }
     private:
-        ParticipantProxy::Implementation* _proxy_impl;
+        ParticipantConnection* _connection;
         RPCComponent<T> _value;
+        mutable std::recursive_mutex _sync;
     };
 
     class InfoCache
@@ -138,18 +160,15 @@ public:
         ConnectStateMachine::State _last_state{ ConnectStateMachine::State::undefined};
     };
 
-    Implementation(const std::string& participant_name,
+    ParticipantConnection(const std::string& participant_name,
         const std::string& participant_url,
         const std::string& system_name,
         const std::string& system_discovery_url,
         ISystemLogger& logger,
-        std::chrono::milliseconds default_timeout) :
-        _participant_name(participant_name),
-        _participant_url(participant_url),
+        bool lazy_connection) :
         _logger(logger),
-        _init_priority(0),
-        _start_priority(0),
-        _default_timeout(default_timeout),
+        _participant_name(participant_name),
+        _lazy_connection(lazy_connection),
         _info(this),
         _state_machine(this),
         _logging(this),
@@ -162,21 +181,24 @@ public:
             throw std::runtime_error(std::string("While contructing ") + participant_name + " at " + participant_url 
                 + "no system connection to " + system_name + " at " + system_discovery_url +" possible");
         }
+        if (_lazy_connection)
+        {
+            //every component connects at its first use (see onComponentConnected)
+            return;
+        }
         _info.getValue();
         //only if info hasValue ... then it makes sense to connect to the others
         //otherwise ther is a huge timeout for every connecting
         if (_info.hasValue())
         {
             _state_machine.getValue();
-            auto logging = _logging.getValue();
-            if (logging)
-            {
-                logging->registerRPCClient(_logger.getUrl());
-                _registered_logging = true;
-            }
+            registerLoggingSink();
         }
     }
-    virtual ~Implementation()
+    ParticipantConnection(const ParticipantConnection&) = delete;
+    ParticipantConnection& operator=(const ParticipantConnection&) = delete;
+
+    ~ParticipantConnection()
     {
         if (_registered_logging)
         {
@@ -188,49 +210,44 @@ public:
         }
     }
 
-    void copyValuesTo(Implementation& other) const
-    {
-        other._participant_name = _participant_name;
-        other._participant_url = _participant_url;
-        other._init_priority = _init_priority;
-        other._start_priority = _start_priority;
-        other._default_timeout = _default_timeout;
-        other._additional_info = _additional_info;
-        other._service_bus_connection = _service_bus_connection;
-        other._system_access = _system_access;
-    }
-
-
-    std::string getParticipantName() const
-    {
-        return _participant_name;
-    }
-
-    std::string getParticipantURL() const
-    {
-        return _participant_url;
-    }
-
-    void setStartPriority(int32_t prio)
-    {
-        _start_priority = prio;
-    }
-
-    int32_t getStartPriority() const
+    /**
+     * Called by the component caches after a component was connected.
+     * A lazy proxy registers the logging sink of the system at the first connected component,
+     * so the participant logs to the system as soon as it is used.
+     */
+    void onComponentConnected()
     {
-        return _start_priority;
+        if (!_lazy_connection)
+        {
+            return;
+        }
+        try
+        {
+            registerLoggingSink();
+        }
+        catch (...)
+        {
+            //the participant is unreachable, the call which connected the component fails on its own
+            //the registration is tried again at the next connected component
+            _logging_sink_requested = false;
+        }
     }
 
-    void setInitPriority(int32_t prio)
+    void registerLoggingSink()
     {
-        _init_priority = prio;
+        bool expected = false;
+        if (!_logging_sink_requested.compare_exchange_strong(expected, true))
+        {
+            return;
+        }
+        auto logging = _logging.getValue();
+        if (logging)
+        {
+            logging->registerRPCClient(_logger.getUrl());
+            _registered_logging = true;
+        }
     }
 
-    int32_t getInitPriority() const
-    {
-        return _init_priority;
-    }    
-
     bool getRPCComponentProxy(const std::string& component_name,
         const std::string& component_iid,
         IRPCComponentPtr& proxy_ptr) const
@@ -410,6 +427,11 @@ public:
         return _info_cache.getComponentsWhichSupports(info, iid, getCurrentState());
     }
 
+    std::string getParticipantName() const
+    {
+        return _participant_name;
+    }
+
     ConnectStateMachine::State getCurrentState() const
     {
         if (_state_machine.hasValue())
@@ -422,6 +444,131 @@ public:
         }
     }
 
+private:
+    ISystemLogger& _logger;
+    const std::string _participant_name;
+    const bool _lazy_connection;
+
+    mutable InfoCache _info_cache;
+    mutable RPCComponentCache<ConnectParticipantInfo>    _info;
+    mutable RPCComponentCache<ConnectStateMachine>       _state_machine;
+    mutable RPCComponentCache<ConnectLoggingSinkService> _logging;
+    std::atomic<bool> _logging_sink_requested{ false };
+    std::atomic<bool> _registered_logging{ false };
+    mutable RPCComponentCache<ConnectConfigurationService> _config;
+
+    //we need to make sure the service bus connection lives as locg the system access is used
+    std::shared_ptr<arya::IServiceBusConnection> _service_bus_connection;
+    std::shared_ptr<arya::IServiceBus::ISystemAccess> _system_access;
+};
+
+/**
+ * The values of a participant proxy (priorities, dependencies and additional info) and its connection.
+ * A copy shares the connection, but not the values.
+ */
+struct ParticipantProxy::Implementation
+{
+public:
+    Implementation(const std::string& participant_name,
+        const std::string& participant_url,
+        const std::string& system_name,
+        const std::string& system_discovery_url,
+        ISystemLogger& logger,
+        std::chrono::milliseconds default_timeout,
+        bool lazy_connection) :
+        _participant_name(participant_name),
+        _participant_url(participant_url),
+        _init_priority(0),
+        _start_priority(0),
+        _default_timeout(default_timeout),
+        _connection(std::make_shared<ParticipantConnection>(participant_name,
+            participant_url,
+            system_name,
+            system_discovery_url,
+            logger,
+            lazy_connection))
+    {
+    }
+
+    Implementation(const Implementation&) = default;
+    Implementation& operator=(const Implementation&) = delete;
+
+    void copyValuesTo(Implementation& other) const
+    {
+        other._participant_name = _participant_name;
+        other._participant_url = _participant_url;
+        other._init_priority = _init_priority;
+        other._start_priority = _start_priority;
+        other._init_dependencies = _init_dependencies;
+        other._start_dependencies = _start_dependencies;
+        other._default_timeout = _default_timeout;
+        other._additional_info = _additional_info;
+    }
+
+
+    std::string getParticipantName() const
+    {
+        return _participant_name;
+    }
+
+    std::string getParticipantURL() const
+    {
+        return _participant_url;
+    }
+
+    void setStartPriority(int32_t prio)
+    {
+        _start_priority = prio;
+    }
+
+    int32_t getStartPriority() const
+    {
+        return _start_priority;
+    }
+
+    void setInitPriority(int32_t prio)
+    {
+        _init_priority = prio;
+    }
+
+    int32_t getInitPriority() const
+    {
+        return _init_priority;
+    }
+
+    void setInitDependencies(const std::vector<std::string>& participant_names)
+    {
+        _init_dependencies = participant_names;
+    }
+
+    std::vector<std::string> getInitDependencies() const
+    {
+        return _init_dependencies;
+    }
+
+    void setStartDependencies(const std::vector<std::string>& participant_names)
+    {
+        _start_dependencies = participant_names;
+    }
+
+    std::vector<std::string> getStartDependencies() const
+    {
+        return _start_dependencies;
+    }    
+
+    bool getRPCComponentProxy(const std::string& component_name,
+        const std::string& component_iid,
+        IRPCComponentPtr& proxy_ptr) const
+    {
+        return _connection->getRPCComponentProxy(component_name, component_iid, proxy_ptr);
+    }
+
+    bool getRPCComponentProxyByIID(const std::string& component_iid,
+        IRPCComponentPtr& proxy_ptr) const
+    {
+        return _connection->getRPCComponentProxyByIID(component_iid, proxy_ptr);
+    }
+
     void setAdditionalInfo(const std::string& key, const std::string& value)
     {
         _additional_info[key] = value;
@@ -441,25 +588,14 @@ public:
     }
 
 private:
-    ISystemLogger& _logger;
     std::string _participant_name;
     std::string _participant_url;
-
-    mutable InfoCache _info_cache;
-    mutable RPCComponentCache<ConnectParticipantInfo>    _info;
-    mutable RPCComponentCache<ConnectStateMachine>       _state_machine;
-    mutable RPCComponentCache<ConnectLoggingSinkService> _logging;
-    bool _registered_logging{ false };
-    mutable RPCComponentCache<ConnectConfigurationService> _config;
-
-    
-
     int32_t _init_priority;
     int32_t _start_priority;
+    std::vector<std::string> _init_dependencies;
+    std::vector<std::string> _start_dependencies;
     std::chrono::milliseconds _default_timeout;
     std::map<std::string, std::string> _additional_info;
-    //we need to make sure the service bus connection lives as locg the system access is used
-    std::shared_ptr<arya::IServiceBusConnection> _service_bus_connection;
-    std::shared_ptr<arya::IServiceBus::ISystemAccess> _system_access;
+    std::shared_ptr<ParticipantConnection> _connection;
 };
 }
@@ -0,0 +1,827 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+#pragma once
+
+#include <fep_system/system_operation.h>
+#include <fep_system/participant_proxy.h>
+#include "system_tracer.h"
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace fep3
+{
+    static constexpr int min_timeout = 500;
+    static constexpr int timeout_divident = 10;
+
+    /**
+     * One call of a set of participants within a system operation (i.e. one transition or one state request).
+     * The participants of one level are called concurrently, the levels are called one after the other.
+     */
+    struct OperationPhase
+    {
+        /**
+         * Result of a finished phase.
+         * The error messages are in order of the levels and the participants.
+         */
+        struct Result
+        {
+            std::string _error_message;
+            ///the indexes of the participants which did not answer until the deadline
+            std::vector<size_t> _missed_deadline;
+            ///the participants of _missed_deadline which did not answer within their own timeout (see setCallTimeout)
+            std::vector<size_t> _missed_call_timeout;
+        };
+        ///calls the participant and returns its error message, throws if the participant can not be connected
+        using ParticipantCall = std::function<std::string(size_t participant_index, const ParticipantProxy& participant)>;
+        ///called within the operation after the last level finished, may add further phases or fail the operation
+        using FinishedCall = std::function<void(SystemOperation::Implementation& operation, const Result& result)>;
+
+        ///levels of participant indexes of the operation
+        std::vector<std::vector<size_t>> _levels;
+        ///levels shared with the priority index of the system, used instead of _levels if set (see getLevels)
+        std::shared_ptr<const std::vector<std::vector<size_t>>> _shared_levels;
+        ParticipantCall _call;
+        FinishedCall _finished;
+        ///deadline of the whole phase, the budget is split across the levels
+        std::chrono::milliseconds _timeout;
+        ///internal requests (i.e. state requests) do not change the progress of the participants
+        bool _report_progress = true;
+        /**
+         * predecessors by participant index, if not empty the phase has one level only
+         * and each participant of it is called as soon as its predecessors (within the level) answered
+         */
+        std::vector<std::vector<size_t>> _predecessors;
+        ///maximum of participants called at the same time within one level, 0 for no limit
+        size_t _max_concurrent_calls = 0;
+        ///if true the limit of concurrent calls per host of the operation is used (see setHostLimit)
+        bool _limit_per_host = true;
+        ///state of a participant which answered successfully (see setStateObserver), undefined if the call does not change it
+        rpc::ParticipantState _reached_state = rpc::ParticipantState::undefined;
+        ///name of the call of each participant (by participant index) for the latency history (see setLatencyObserver), empty if not recorded
+        std::vector<std::string> _call_names;
+
+        const std::vector<std::vector<size_t>>& getLevels() const
+        {
+            return _shared_levels ? *_shared_levels : _levels;
+        }
+    };
+
+    /**
+     * The state of one system operation.
+     * The operation is driven by the answers of the participants and by the deadline timers of the worker pool,
+     * nobody has to wait for it.
+     */
+    struct SystemOperation::Implementation : public std::enable_shared_from_this<SystemOperation::Implementation>
+    {
+    public:
+        Implementation(WorkerPool& worker_pool,
+            const std::vector<ParticipantProxy>& participants,
+            const std::string& description)
+            : _worker_pool(worker_pool),
+              _participants(participants),
+              _description(description),
+              _created(std::chrono::steady_clock::now()),
+              _call_status(participants.size(), ParticipantProgress::Status::pending),
+              _call_begin(participants.size()),
+              _call_tasks(participants.size()),
+              _errors(participants.size()),
+              _connect_errors(participants.size()),
+              _open_predecessors(participants.size()),
+              _successors(participants.size())
+        {
+            for (const auto& participant : _participants)
+            {
+                _progress.push_back({ participant.getName(), ParticipantProgress::Status::pending, {} });
+            }
+        }
+
+        Implementation(const Implementation&) = delete;
+        Implementation& operator=(const Implementation&) = delete;
+
+        /**
+         * Calculates the deadline of the next level of a phase.
+         * A level may use the remaining budget up to @p deadline but has to leave a reserve
+         * of timeout / timeout_divident (at least min_timeout) for each of the following levels.
+         * Each level gets at least its equal share of the remaining budget.
+         */
+        static std::chrono::steady_clock::time_point getLevelDeadline(std::chrono::steady_clock::time_point deadline,
+            std::chrono::milliseconds timeout,
+            size_t levels_left)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline || levels_left <= 1)
+            {
+                return deadline;
+            }
+            const auto levels = static_cast<std::chrono::steady_clock::rep>(levels_left);
+            const std::chrono::steady_clock::duration remaining = deadline - now;
+            const std::chrono::steady_clock::duration reserve =
+                std::max(timeout / timeout_divident, std::chrono::milliseconds(min_timeout)) * (levels - 1);
+            return now + std::max(remaining / levels, remaining - reserve);
+        }
+
+        const std::vector<ParticipantProxy>& getParticipants() const
+        {
+            return _participants;
+        }
+
+        /**
+         * Limits the calls of one host which run at the same time.
+         * @param hosts the host of each participant, participants with an empty host are not limited
+         * @param max_concurrent_calls_per_host the maximum, 0 for no limit
+         */
+        void setHostLimit(const std::vector<std::string>& hosts, size_t max_concurrent_calls_per_host)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            _max_concurrent_calls_per_host = max_concurrent_calls_per_host;
+            std::map<std::string, size_t> host_ids;
+            _host_ids.assign(_participants.size(), static_cast<size_t>(no_host));
+            for (size_t index = 0; index < hosts.size() && index < _participants.size(); ++index)
+            {
+                if (!hosts[index].empty())
+                {
+                    _host_ids[index] = host_ids.emplace(hosts[index], host_ids.size()).first->second;
+                }
+            }
+            _running_calls_per_host.assign(host_ids.size(), 0);
+        }
+
+        ///called with every state of a participant the operation learned (i.e. the target state of a transition)
+        using StateObserver = std::function<void(const std::string& participant_name, rpc::ParticipantState state)>;
+
+        void setStateObserver(const StateObserver& observer)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            _state_observer = observer;
+        }
+
+        ///reports a state of a participant which was requested within a phase
+        void reportState(size_t participant_index, rpc::ParticipantState state)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            if (_state_observer)
+            {
+                _state_observer(_participants[participant_index].getName(), state);
+            }
+        }
+
+        ///called with the duration of every named call of a participant (see OperationPhase::_call_names), also if it answered too late
+        using LatencyObserver = std::function<void(const std::string& call_name,
+            const std::string& participant_name,
+            std::chrono::steady_clock::duration duration)>;
+
+        void setLatencyObserver(const LatencyObserver& observer)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            _latency_observer = observer;
+        }
+
+        ///gets the own timeout of a named call of a participant (see OperationPhase::_call_names), 0 if there is none
+        using CallTimeout = std::function<std::chrono::milliseconds(const std::string& call_name,
+            const std::string& participant_name)>;
+
+        /**
+         * Sets the own timeouts of the named calls. A call which does not answer within its own timeout
+         * is reported like a participant which missed the deadline of the phase.
+         * The deadline of a level is extended to the longest own timeout of its participants if necessary,
+         * but never beyond the deadline of the phase.
+         */
+        void setCallTimeout(const CallTimeout& call_timeout)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            _call_timeout = call_timeout;
+        }
+
+        /**
+         * Observes the named calls of the phases (see OperationPhase::_call_names), i.e. to report the progress of a transition.
+         * It is called within the operation (one call at a time), so it must not block.
+         */
+        class ProgressObserver
+        {
+        public:
+            virtual ~ProgressObserver() = default;
+            ///a phase with named calls starts, @p call_names by participant index (empty if the participant is not called)
+            virtual void onPhaseStarted(const std::vector<std::string>& call_names) = 0;
+            ///the named call of a participant finished with done, failed or timed_out
+            virtual void onCallFinished(size_t participant_index,
+                ParticipantProgress::Status status,
+                std::chrono::steady_clock::duration duration) = 0;
+            ///the phase finished, also if the operation failed or was cancelled
+            virtual void onPhaseFinished() = 0;
+        };
+
+        void setProgressObserver(const std::shared_ptr<ProgressObserver>& observer)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            _progress_observer = observer;
+        }
+
+        /**
+         * Traces the operation and the calls of its participants as @p operation_name of @p system_name
+         * while tracing is enabled (see SystemTracer). The calls are traced by their names
+         * (see OperationPhase::_call_names), unnamed calls by @p operation_name.
+         */
+        void setTraceName(const std::string& system_name, const std::string& operation_name)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            _trace_system_name = system_name;
+            _trace_operation_name = operation_name;
+        }
+
+        void addPhase(OperationPhase phase)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            _phases.push_back(std::move(phase));
+        }
+
+        void start()
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            if (!_done)
+            {
+                startNextPhase();
+            }
+        }
+
+        void fail(std::exception_ptr error)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            if (!_done)
+            {
+                finish(error);
+            }
+        }
+
+        ///reports a participant which does not need to be called as done
+        void skip(size_t participant_index)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            _progress[participant_index]._status = ParticipantProgress::Status::done;
+            _progress[participant_index]._error_message.clear();
+        }
+
+        void cancel()
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            if (_done)
+            {
+                return;
+            }
+            for (auto& progress : _progress)
+            {
+                if (progress._status == ParticipantProgress::Status::pending
+                    || progress._status == ParticipantProgress::Status::running)
+                {
+                    progress._status = ParticipantProgress::Status::cancelled;
+                }
+            }
+            finish(std::make_exception_ptr(std::runtime_error(_description + " cancelled")));
+        }
+
+        bool isDone() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            return _done;
+        }
+
+        bool waitUntil(std::chrono::steady_clock::time_point deadline) const
+        {
+            std::unique_lock<std::recursive_mutex> lock(_sync);
+            return _done_changed.wait_until(lock, deadline, [this]() { return _done; });
+        }
+
+        void wait() const
+        {
+            std::unique_lock<std::recursive_mutex> lock(_sync);
+            _done_changed.wait(lock, [this]() { return _done; });
+        }
+
+        void get() const
+        {
+            std::unique_lock<std::recursive_mutex> lock(_sync);
+            _done_changed.wait(lock, [this]() { return _done; });
+            if (_error)
+            {
+                std::rethrow_exception(_error);
+            }
+        }
+
+        std::vector<ParticipantProgress> getParticipantProgress() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            return _progress;
+        }
+
+    private:
+        OperationPhase& currentPhase()
+        {
+            return _phases.front();
+        }
+
+        void startNextPhase()
+        {
+            if (_phases.empty())
+            {
+                finish({});
+                return;
+            }
+            _phase_deadline = std::chrono::steady_clock::now() + currentPhase()._timeout;
+            _current_level = 0;
+            _phase_result = {};
+            std::fill(_call_status.begin(), _call_status.end(), ParticipantProgress::Status::pending);
+            std::fill(_call_begin.begin(), _call_begin.end(), std::chrono::steady_clock::time_point());
+            const auto& call_names = currentPhase()._call_names;
+            if (_progress_observer
+                && std::any_of(call_names.begin(), call_names.end(), [](const std::string& name) { return !name.empty(); }))
+            {
+                _phase_observed = true;
+                _progress_observer->onPhaseStarted(call_names);
+            }
+            dispatchLevel();
+        }
+
+        void dispatchLevel()
+        {
+            auto& phase = currentPhase();
+            const auto& levels = phase.getLevels();
+            if (_current_level >= levels.size())
+            {
+                finishPhase();
+                return;
+            }
+            const auto& level = levels[_current_level];
+            auto level_deadline =
+                getLevelDeadline(_phase_deadline, phase._timeout, levels.size() - _current_level);
+            std::chrono::milliseconds longest_call_timeout(0);
+            for (auto participant_index : level)
+            {
+                longest_call_timeout = std::max(longest_call_timeout, getCallTimeout(participant_index));
+            }
+            if (longest_call_timeout.count() > 0)
+            {
+                //the participants of the level are limited by their own timeouts and get at least these,
+                //but never more than the deadline of the phase (the timeout of the caller)
+                level_deadline = std::min(_phase_deadline,
+                    std::max(level_deadline, std::chrono::steady_clock::now() + longest_call_timeout));
+            }
+            const auto level_id = ++_level_id;
+            _running_calls = 0;
+            std::fill(_running_calls_per_host.begin(), _running_calls_per_host.end(), 0);
+            _ready.clear();
+            _dispatch_stopped = false;
+            if (level.empty() || std::chrono::steady_clock::now() >= level_deadline)
+            {
+                //nothing to wait for or no budget left, the participants of the level are not called at all
+                finishLevel();
+                return;
+            }
+            if (phase._predecessors.empty())
+            {
+                _ready.assign(level.begin(), level.end());
+            }
+            else
+            {
+                //only the participants without open predecessors are ready, the others follow in onParticipantDone
+                for (auto participant_index : level)
+                {
+                    _open_predecessors[participant_index] = 0;
+                    _successors[participant_index].clear();
+                }
+                for (auto participant_index : level)
+                {
+                    for (auto predecessor : phase._predecessors[participant_index])
+                    {
+                        if (std::find(level.begin(), level.end(), predecessor) != level.end())
+                        {
+                            ++_open_predecessors[participant_index];
+                            _successors[predecessor].push_back(participant_index);
+                        }
+                    }
+                }
+                for (auto participant_index : level)
+                {
+                    if (_open_predecessors[participant_index] == 0)
+                    {
+                        _ready.push_back(participant_index);
+                    }
+                }
+            }
+            auto self = shared_from_this();
+            _worker_pool.postAt(level_deadline, [self, level_id]()
+            {
+                self->onDeadline(level_id);
+            });
+            callReady(level_id);
+        }
+
+        ///calls the ready participants of the level as long as the limit of concurrent calls allows it
+        void callReady(uint64_t level_id)
+        {
+            const auto max_concurrent_calls = currentPhase()._max_concurrent_calls;
+            for (auto ready = _ready.begin(); ready != _ready.end() && !_dispatch_stopped
+                && (max_concurrent_calls == 0 || _running_calls < max_concurrent_calls);)
+            {
+                const auto participant_index = *ready;
+                const auto host_id = getHostId(participant_index);
+                if (host_id != no_host && _running_calls_per_host[host_id] >= _max_concurrent_calls_per_host)
+                {
+                    //the host is busy, other hosts may go on
+                    ++ready;
+                    continue;
+                }
+                ready = _ready.erase(ready);
+                ++_running_calls;
+                if (host_id != no_host)
+                {
+                    ++_running_calls_per_host[host_id];
+                }
+                callParticipant(level_id, participant_index);
+            }
+            if (_running_calls == 0)
+            {
+                //nothing left which may be called
+                finishLevel();
+            }
+        }
+
+        void callParticipant(uint64_t level_id, size_t participant_index)
+        {
+            setStatus(participant_index, ParticipantProgress::Status::running, {});
+            auto self = shared_from_this();
+            auto call = currentPhase()._call;
+            auto participant = _participants[participant_index];
+            std::string call_name;
+            if (participant_index < currentPhase()._call_names.size())
+            {
+                call_name = currentPhase()._call_names[participant_index];
+            }
+            const auto latency_observer = _latency_observer;
+            std::string trace_system_name;
+            std::string trace_name;
+            if (!_trace_operation_name.empty() && SystemTracer::get().isEnabled())
+            {
+                trace_system_name = _trace_system_name;
+                trace_name = call_name.empty() ? _trace_operation_name : call_name;
+            }
+            _call_begin[participant_index] = std::chrono::steady_clock::now();
+            const auto call_timeout = getCallTimeout(participant_index);
+            if (call_timeout.count() > 0)
+            {
+                _worker_pool.postAt(std::chrono::steady_clock::now() + call_timeout, [self, level_id, participant_index]()
+                {
+                    self->onCallDeadline(level_id, participant_index);
+                });
+            }
+            _call_tasks[participant_index] = _worker_pool.postAbandonable([self, level_id, participant_index, participant,
+                call, call_name, latency_observer, trace_system_name, trace_name]()
+            {
+                std::string error_message;
+                std::exception_ptr connect_error;
+                const auto call_begin = std::chrono::steady_clock::now();
+                try
+                {
+                    error_message = call(participant_index, participant);
+                }
+                catch (...)
+                {
+                    connect_error = std::current_exception();
+                }
+                const auto call_end = std::chrono::steady_clock::now();
+                if (latency_observer && !call_name.empty())
+                {
+                    latency_observer(call_name, participant.getName(), call_end - call_begin);
+                }
+                if (!trace_name.empty())
+                {
+                    SystemTracer::get().record(SystemTracer::call, trace_name, trace_system_name, participant.getName(),
+                        call_begin, call_end, !connect_error && error_message.empty());
+                }
+                self->onParticipantDone(level_id, participant_index, error_message, connect_error);
+            });
+        }
+
+        void addReadySuccessors(size_t participant_index)
+        {
+            for (auto successor : _successors[participant_index])
+            {
+                if (--_open_predecessors[successor] == 0)
+                {
+                    _ready.push_back(successor);
+                }
+            }
+        }
+
+        void onParticipantDone(uint64_t level_id,
+            size_t participant_index,
+            const std::string& error_message,
+            std::exception_ptr connect_error)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            if (_done || level_id != _level_id
+                || _call_status[participant_index] == ParticipantProgress::Status::timed_out)
+            {
+                //too late, the participant is already reported as timed out
+                return;
+            }
+            _call_tasks[participant_index].reset();
+            _errors[participant_index] = error_message;
+            _connect_errors[participant_index] = connect_error;
+            if (connect_error || !error_message.empty())
+            {
+                setStatus(participant_index, ParticipantProgress::Status::failed,
+                    connect_error ? getMessage(connect_error) : error_message);
+            }
+            else
+            {
+                setStatus(participant_index, ParticipantProgress::Status::done, {});
+                if (currentPhase()._reached_state != rpc::ParticipantState::undefined)
+                {
+                    reportState(participant_index, currentPhase()._reached_state);
+                }
+            }
+            if (connect_error)
+            {
+                //like the following levels the waiting participants are not called anymore
+                _dispatch_stopped = true;
+            }
+            if (!currentPhase()._predecessors.empty())
+            {
+                addReadySuccessors(participant_index);
+            }
+            --_running_calls;
+            const auto host_id = getHostId(participant_index);
+            if (host_id != no_host)
+            {
+                --_running_calls_per_host[host_id];
+            }
+            callReady(level_id);
+        }
+
+        ///the own timeout of a call is reached (see setCallTimeout)
+        void onCallDeadline(uint64_t level_id, size_t participant_index)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            if (_done || level_id != _level_id
+                || _call_status[participant_index] != ParticipantProgress::Status::running)
+            {
+                return;
+            }
+            setStatus(participant_index, ParticipantProgress::Status::timed_out, {});
+            _phase_result._missed_deadline.push_back(participant_index);
+            _phase_result._missed_call_timeout.push_back(participant_index);
+            if (!currentPhase()._predecessors.empty())
+            {
+                addReadySuccessors(participant_index);
+            }
+            --_running_calls;
+            const auto host_id = getHostId(participant_index);
+            if (host_id != no_host)
+            {
+                --_running_calls_per_host[host_id];
+            }
+            callReady(level_id);
+        }
+
+        void onDeadline(uint64_t level_id)
+        {
+            std::lock_guard<std::recursive_mutex> lock(_sync);
+            if (_done || level_id != _level_id)
+            {
+                return;
+            }
+            finishLevel();
+        }
+
+        void finishLevel()
+        {
+            //answers and timers of this level which arrive later are ignored
+            ++_level_id;
+            std::exception_ptr connect_error;
+            for (auto participant_index : currentPhase().getLevels()[_current_level])
+            {
+                const auto status = _call_status[participant_index];
+                if (status == ParticipantProgress::Status::pending && _dispatch_stopped)
+                {
+                    //not called because another participant can not be connected
+                    continue;
+                }
+                if (status == ParticipantProgress::Status::pending
+                    || status == ParticipantProgress::Status::running)
+                {
+                    setStatus(participant_index, ParticipantProgress::Status::timed_out, {});
+                    _phase_result._missed_deadline.push_back(participant_index);
+                    continue;
+                }
+                _phase_result._error_message += _errors[participant_index];
+                if (!connect_error)
+                {
+                    connect_error = _connect_errors[participant_index];
+                }
+                _errors[participant_index].clear();
+                _connect_errors[participant_index] = nullptr;
+            }
+            if (connect_error)
+            {
+                finish(connect_error);
+                return;
+            }
+            ++_current_level;
+            dispatchLevel();
+        }
+
+        ///the host of the participant if its calls are limited by the current phase
+        size_t getHostId(size_t participant_index)
+        {
+            if (_max_concurrent_calls_per_host == 0 || !currentPhase()._limit_per_host || _host_ids.empty())
+            {
+                return no_host;
+            }
+            return _host_ids[participant_index];
+        }
+
+        std::chrono::milliseconds getCallTimeout(size_t participant_index)
+        {
+            const auto& call_names = currentPhase()._call_names;
+            if (!_call_timeout || participant_index >= call_names.size() || call_names[participant_index].empty())
+            {
+                return std::chrono::milliseconds(0);
+            }
+            return _call_timeout(call_names[participant_index], _participants[participant_index].getName());
+        }
+
+        void finishPhase()
+        {
+            notifyPhaseFinished();
+            auto finished = std::move(currentPhase()._finished);
+            auto result = std::move(_phase_result);
+            _phases.pop_front();
+            if (finished)
+            {
+                try
+                {
+                    finished(*this, result);
+                }
+                catch (...)
+                {
+                    finish(std::current_exception());
+                }
+            }
+            if (!_done)
+            {
+                startNextPhase();
+            }
+        }
+
+        void finish(std::exception_ptr error)
+        {
+            notifyPhaseFinished();
+            if (!_trace_operation_name.empty())
+            {
+                SystemTracer::get().record(SystemTracer::operation, _trace_operation_name, _trace_system_name, {},
+                    _created, std::chrono::steady_clock::now(), !error);
+            }
+            //calls still running (i.e. of a cancelled operation) are not waited for
+            for (size_t participant_index = 0; participant_index < _call_tasks.size(); ++participant_index)
+            {
+                abandonCall(participant_index);
+            }
+            ++_level_id;
+            _done = true;
+            _error = error;
+            _phases.clear();
+            _done_changed.notify_all();
+        }
+
+        void setStatus(size_t participant_index, ParticipantProgress::Status status, const std::string& error_message)
+        {
+            if (status == ParticipantProgress::Status::timed_out)
+            {
+                abandonCall(participant_index);
+            }
+            _call_status[participant_index] = status;
+            if (currentPhase()._report_progress)
+            {
+                _progress[participant_index]._status = status;
+                _progress[participant_index]._error_message = error_message;
+            }
+            if (_phase_observed
+                && (status == ParticipantProgress::Status::done
+                    || status == ParticipantProgress::Status::failed
+                    || status == ParticipantProgress::Status::timed_out)
+                && participant_index < currentPhase()._call_names.size()
+                && !currentPhase()._call_names[participant_index].empty())
+            {
+                //a participant which was not called at all has no duration
+                const auto call_begin = _call_begin[participant_index];
+                _progress_observer->onCallFinished(participant_index, status,
+                    call_begin == std::chrono::steady_clock::time_point()
+                        ? std::chrono::steady_clock::duration(0)
+                        : std::chrono::steady_clock::now() - call_begin);
+            }
+        }
+
+        ///the operation does not wait for the call of the participant anymore, so it does not occupy a worker
+        void abandonCall(size_t participant_index)
+        {
+            auto& call_task = _call_tasks[participant_index];
+            if (call_task)
+            {
+                _worker_pool.abandon(call_task);
+                call_task.reset();
+            }
+        }
+
+        void notifyPhaseFinished()
+        {
+            if (_phase_observed)
+            {
+                _phase_observed = false;
+                _progress_observer->onPhaseFinished();
+            }
+        }
+
+        static std::string getMessage(std::exception_ptr error)
+        {
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch (const std::exception& ex)
+            {
+                return ex.what();
+            }
+            catch (...)
+            {
+                return "unknown error";
+            }
+        }
+
+        WorkerPool& _worker_pool;
+        const std::vector<ParticipantProxy> _participants;
+        const std::string _description;
+        const std::chrono::steady_clock::time_point _created;
+        std::string _trace_system_name;
+        ///empty if the operation is not traced
+        std::string _trace_operation_name;
+        std::deque<OperationPhase> _phases;
+        std::chrono::steady_clock::time_point _phase_deadline;
+        OperationPhase::Result _phase_result;
+        size_t _current_level{ 0 };
+        size_t _running_calls{ 0 };
+        std::deque<size_t> _ready;
+        static constexpr size_t no_host = static_cast<size_t>(-1);
+        std::vector<size_t> _host_ids;
+        std::vector<size_t> _running_calls_per_host;
+        size_t _max_concurrent_calls_per_host{ 0 };
+        uint64_t _level_id{ 0 };
+        std::vector<ParticipantProgress::Status> _call_status;
+        ///start of the call of each participant within the current phase, unset if not called
+        std::vector<std::chrono::steady_clock::time_point> _call_begin;
+        ///the calls of the current level within the worker pool, abandoned if the participant is not waited for anymore
+        std::vector<std::shared_ptr<WorkerPool::Task>> _call_tasks;
+        std::vector<std::string> _errors;
+        std::vector<std::exception_ptr> _connect_errors;
+        std::vector<size_t> _open_predecessors;
+        std::vector<std::vector<size_t>> _successors;
+        bool _dispatch_stopped{ false };
+        std::vector<ParticipantProgress> _progress;
+        StateObserver _state_observer;
+        LatencyObserver _latency_observer;
+        CallTimeout _call_timeout;
+        std::shared_ptr<ProgressObserver> _progress_observer;
+        ///true while a phase is reported to the progress observer
+        bool _phase_observed{ false };
+        bool _done{ false };
+        std::exception_ptr _error;
+        mutable std::recursive_mutex _sync;
+        mutable std::condition_variable_any _done_changed;
+    };
+}
@@ -64,15 +64,15 @@ public:
 
     static std::map<std::string, rpc::IRPCParticipantStateMachine::State>& getStateMap()
     {
-        static std::map<std::string, rpc::IRPCParticipantStateMachine::State> state_map;
-        if (state_map.size() == 0)
+        //initialized once (thread safe), the states of several participants are requested concurrently
+        static std::map<std::string, rpc::IRPCParticipantStateMachine::State> state_map =
         {
-            state_map["Loaded"] = rpc::IRPCParticipantStateMachine::State::loaded;
-            state_map["Initialized"] = rpc::IRPCParticipantStateMachine::State::initialized;
-            state_map["Paused"] = rpc::IRPCParticipantStateMachine::State::paused;
-            state_map["Unloaded"] = rpc::IRPCParticipantStateMachine::State::unloaded;
-            state_map["Running"] = rpc::IRPCParticipantStateMachine::State::running;
-        }
+            { "Loaded", rpc::IRPCParticipantStateMachine::State::loaded },
+            { "Initialized", rpc::IRPCParticipantStateMachine::State::initialized },
+            { "Paused", rpc::IRPCParticipantStateMachine::State::paused },
+            { "Unloaded", rpc::IRPCParticipantStateMachine::State::unloaded },
+            { "Running", rpc::IRPCParticipantStateMachine::State::running }
+        };
         return state_map;
     }
 
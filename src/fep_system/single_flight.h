@@ -0,0 +1,146 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace fep3
+{
+    /**
+     * @brief Coalesces concurrent identical queries (i.e. System::getSystemState of several monitoring threads).
+     * The first caller of a key executes the query, callers of the same key arriving meanwhile wait for it
+     * and receive its result (or its error).
+     * Optionally the last result of each key is reused for the given maximum age, as long as the
+     * version (see the CTOR) did not change since the result was received.
+     */
+    template<typename Key, typename Result>
+    class SingleFlight
+    {
+    public:
+        ///gets a counter which changes whenever the cached results become invalid
+        using Version = std::function<uint64_t()>;
+
+        explicit SingleFlight(const Version& version) : _version(version)
+        {
+        }
+
+        SingleFlight(const SingleFlight&) = delete;
+        SingleFlight& operator=(const SingleFlight&) = delete;
+
+        ///sets the maximum age of a reused result, 0 to reuse results of running queries only
+        void setMaxAge(std::chrono::milliseconds max_age)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            _max_age = max_age;
+            _cache.clear();
+        }
+
+        std::chrono::milliseconds getMaxAge() const
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            return _max_age;
+        }
+
+        Result get(const Key& key, const std::function<Result()>& query)
+        {
+            std::unique_lock<std::mutex> lock(_sync);
+            auto cached = _cache.find(key);
+            if (cached != _cache.end())
+            {
+                if (std::chrono::steady_clock::now() - cached->second._received <= _max_age
+                    && cached->second._version == _version())
+                {
+                    return cached->second._result;
+                }
+                _cache.erase(cached);
+            }
+            auto running = _flights.find(key);
+            if (running != _flights.end())
+            {
+                auto flight = running->second;
+                _landed.wait(lock, [&flight]() { return flight->_done; });
+                if (flight->_error)
+                {
+                    std::rethrow_exception(flight->_error);
+                }
+                return flight->_result;
+            }
+            auto flight = std::make_shared<Flight>();
+            _flights[key] = flight;
+            lock.unlock();
+
+            Result result{};
+            std::exception_ptr error;
+            try
+            {
+                result = query();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            flight->_result = result;
+            flight->_error = error;
+            flight->_done = true;
+            _flights.erase(key);
+            if (!error && _max_age.count() > 0)
+            {
+                _cache[key] = { result, std::chrono::steady_clock::now(), _version() };
+            }
+            _landed.notify_all();
+            lock.unlock();
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+            return result;
+        }
+
+    private:
+        struct Flight
+        {
+            bool _done = false;
+            Result _result{};
+            std::exception_ptr _error;
+        };
+        struct CachedResult
+        {
+            Result _result;
+            std::chrono::steady_clock::time_point _received;
+            uint64_t _version;
+        };
+
+        const Version _version;
+        std::chrono::milliseconds _max_age{ 0 };
+        std::map<Key, std::shared_ptr<Flight>> _flights;
+        std::map<Key, CachedResult> _cache;
+        mutable std::mutex _sync;
+        std::condition_variable _landed;
+    };
+}
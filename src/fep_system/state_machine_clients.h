@@ -0,0 +1,97 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+#pragma once
+#include <fep_system/participant_proxy.h>
+#include <fep_system/rpc_services/participant_statemachine/participant_statemachine_rpc_intf.h>
+
+#include <mutex>
+#include <vector>
+
+namespace fep3
+{
+    /**
+     * @brief The state machine clients of a fixed list of participants, addressed by the index of the participant.
+     * The client of a participant is looked up at its first state request and reused by every further request,
+     * so requesting a state is exactly one RPC.
+     * Participants without a state machine (or not reachable at the lookup) are looked up again at their next request,
+     * since they may be started meanwhile.
+     */
+    class StateMachineClients
+    {
+    public:
+        using State = rpc::arya::IRPCParticipantStateMachine::State;
+
+        explicit StateMachineClients(std::vector<ParticipantProxy> participants)
+            : _participants(std::move(participants)),
+              _clients(_participants.size())
+        {
+        }
+
+        StateMachineClients(const StateMachineClients&) = delete;
+        StateMachineClients& operator=(const StateMachineClients&) = delete;
+
+        const std::vector<ParticipantProxy>& getParticipants() const
+        {
+            return _participants;
+        }
+
+        /**
+         * Requests the state of the participant at @p participant_index.
+         *
+         * @return the state, unreachable if the participant can not be connected or has no state machine
+         * \throw runtime_error if the participant does not answer the request
+         */
+        State requestState(size_t participant_index)
+        {
+            const auto state_machine = getClient(participant_index);
+            if (!state_machine)
+            {
+                //the participant can not be connected ... maybe it was shutdown or whatever
+                //or the participant has no state machine, this is ok
+                //... i.e. a recorder will have no states and a signal listener tool will have no states
+                return State::unreachable;
+            }
+            return state_machine->getState();
+        }
+
+    private:
+        RPCComponent<rpc::arya::IRPCParticipantStateMachine> getClient(size_t participant_index)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_sync);
+                if (_clients[participant_index])
+                {
+                    return _clients[participant_index];
+                }
+            }
+            //the lookup may call the participant, so it is done without the lock
+            auto state_machine = _participants[participant_index]
+                .getRPCComponentProxyByIID<rpc::arya::IRPCParticipantStateMachine>();
+            std::lock_guard<std::mutex> lock(_sync);
+            _clients[participant_index] = state_machine;
+            return state_machine;
+        }
+
+        const std::vector<ParticipantProxy> _participants;
+        std::vector<RPCComponent<rpc::arya::IRPCParticipantStateMachine>> _clients;
+        std::mutex _sync;
+    };
+}
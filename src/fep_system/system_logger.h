@@ -27,35 +27,32 @@
 #include <fep3/components/service_bus/rpc/fep_rpc.h>
 #include "fep_system_stubs/logging_sink_stub.h"
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 
 namespace fep3
 {
+    class SystemLogger;
+
     using LogSink = rpc::RPCService<rpc_proxy_stub::RPCLoggingSink, rpc::IRPCLoggingSinkClientDef>;
     class LogSinkImpl : public LogSink
     {
     private:
-        ISystemLogger& _system_logger;
+        SystemLogger& _system_logger;
 
     public:
-        explicit LogSinkImpl(ISystemLogger& system_logger) : _system_logger(system_logger)
+        explicit LogSinkImpl(SystemLogger& system_logger) : _system_logger(system_logger)
         {
         }
         int onLog(const std::string& description,
             const std::string& logger_name,
             const std::string& participant,
             int severity,
-            const std::string& timestamp) override
-        {
-            _system_logger.log(
-                std::chrono::milliseconds(a_util::strings::toInt64(timestamp)),
-                static_cast<logging::Severity>(severity),
-                participant,
-                logger_name,
-                description);
-            return 0;
-        }
+            const std::string& timestamp) override;
     };
 
     class SystemLogger : 
@@ -69,13 +66,85 @@ namespace fep3
         void registerMonitor(IEventMonitor* monitor)
         {
             std::lock_guard<std::recursive_mutex> _lock(_synch_event_monitor);
+            std::lock_guard<std::recursive_mutex> _notification_lock(_synch_event_notification);
             _monitor = monitor;
+            _has_monitor = (monitor != nullptr);
         }
 
         void releaseMonitor()
         {
             std::lock_guard<std::recursive_mutex> _lock(_synch_event_monitor);
+            std::lock_guard<std::recursive_mutex> _notification_lock(_synch_event_notification);
             _monitor = nullptr;
+            _has_monitor = false;
+        }
+
+        ///does not wait for a running notification (see notifyMonitor)
+        bool hasMonitor() const
+        {
+            return _has_monitor;
+        }
+
+        /**
+         * Calls @p notify with the registered monitor (if any).
+         * The notifications are not synchronized with the log messages, so a slow notification does not delay them.
+         */
+        void notifyMonitor(const std::function<void(IEventMonitor&)>& notify) const
+        {
+            std::lock_guard<std::recursive_mutex> _notification_lock(_synch_event_notification);
+            if (_monitor)
+            {
+                notify(*_monitor);
+            }
+        }
+
+        /**
+         * Forwards the logs the participants send to the sink of this logger to @p logger.
+         * The copies of a system share the connections to the participants and the participants log
+         * to the sink of the system which connected them, so the copies receive the logs by forwarding.
+         */
+        void addLogForward(const std::shared_ptr<SystemLogger>& logger)
+        {
+            std::lock_guard<std::mutex> lock(_sync_log_forwards);
+            _log_forwards.push_back(logger);
+        }
+
+        ///only the forwarded logs of participants accepted by @p filter are logged (all if not set)
+        void setForwardFilter(const std::function<bool(const std::string& participant_name)>& filter)
+        {
+            std::lock_guard<std::recursive_mutex> _lock(_synch_event_monitor);
+            _forward_filter = filter;
+        }
+
+        ///logs a message a participant sent to the sink and forwards it (see addLogForward)
+        void logFromParticipant(const std::chrono::milliseconds& time_as_ms,
+            logging::Severity level,
+            const std::string& participant_name,
+            const std::string& logger_name,
+            const std::string& message)
+        {
+            log(time_as_ms, level, participant_name, logger_name, message);
+            std::vector<std::shared_ptr<SystemLogger>> forwards;
+            {
+                std::lock_guard<std::mutex> lock(_sync_log_forwards);
+                auto forward = _log_forwards.begin();
+                while (forward != _log_forwards.end())
+                {
+                    if (auto logger = forward->lock())
+                    {
+                        forwards.push_back(std::move(logger));
+                        ++forward;
+                    }
+                    else
+                    {
+                        forward = _log_forwards.erase(forward);
+                    }
+                }
+            }
+            for (const auto& logger : forwards)
+            {
+                logger->logForwarded(time_as_ms, level, participant_name, logger_name, message);
+            }
         }
 
         void log(const std::chrono::milliseconds& time_as_ms,
@@ -166,10 +235,43 @@ namespace fep3
 
         logging::Severity _level = logging::Severity::info;
         IEventMonitor* _monitor = nullptr;
+        std::atomic<bool> _has_monitor{ false };
         mutable std::recursive_mutex _synch_event_monitor;
+        mutable std::recursive_mutex _synch_event_notification;
         std::shared_ptr<arya::IServiceBus::ISystemAccess> _system_access;
         std::shared_ptr<arya::IServiceBusConnection> _servicebus_connection;
         std::shared_ptr<LogSinkImpl> _log_sink_impl;
-        
+        std::function<bool(const std::string& participant_name)> _forward_filter;
+        std::vector<std::weak_ptr<SystemLogger>> _log_forwards;
+        std::mutex _sync_log_forwards;
+
+    private:
+        void logForwarded(const std::chrono::milliseconds& time_as_ms,
+            logging::Severity level,
+            const std::string& participant_name,
+            const std::string& logger_name,
+            const std::string& message) const
+        {
+            std::lock_guard<std::recursive_mutex> _lock(_synch_event_monitor);
+            if (!_forward_filter || _forward_filter(participant_name))
+            {
+                log(time_as_ms, level, participant_name, logger_name, message);
+            }
+        }
     };
+
+    inline int LogSinkImpl::onLog(const std::string& description,
+        const std::string& logger_name,
+        const std::string& participant,
+        int severity,
+        const std::string& timestamp)
+    {
+        _system_logger.logFromParticipant(
+            std::chrono::milliseconds(a_util::strings::toInt64(timestamp)),
+            static_cast<logging::Severity>(severity),
+            participant,
+            logger_name,
+            description);
+        return 0;
+    }
 }
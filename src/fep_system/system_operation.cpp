@@ -0,0 +1,85 @@
+/*
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+   
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+   
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+   
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim 
+ *
+ */
+
+#include <fep_system/system_operation.h>
+#include <private_system_operation.hpp>
+
+namespace fep3
+{
+
+SystemOperation::~SystemOperation()
+{
+}
+
+SystemOperation::SystemOperation(const std::shared_ptr<Implementation>& impl) : _impl(impl)
+{
+}
+
+SystemOperation::SystemOperation(const SystemOperation& other) : _impl(other._impl)
+{
+}
+
+SystemOperation& SystemOperation::operator=(const SystemOperation& other)
+{
+    _impl = other._impl;
+    return *this;
+}
+
+SystemOperation::SystemOperation(SystemOperation&& other) : _impl(std::move(other._impl))
+{
+}
+
+SystemOperation& SystemOperation::operator=(SystemOperation&& other)
+{
+    _impl = std::move(other._impl);
+    return *this;
+}
+
+bool SystemOperation::isDone() const
+{
+    return _impl->isDone();
+}
+
+void SystemOperation::wait() const
+{
+    _impl->wait();
+}
+
+bool SystemOperation::waitFor(std::chrono::milliseconds timeout) const
+{
+    return _impl->waitUntil(std::chrono::steady_clock::now() + timeout);
+}
+
+void SystemOperation::get() const
+{
+    _impl->get();
+}
+
+void SystemOperation::cancel() const
+{
+    _impl->cancel();
+}
+
+std::vector<ParticipantProgress> SystemOperation::getParticipantProgress() const
+{
+    return _impl->getParticipantProgress();
+}
+
+}
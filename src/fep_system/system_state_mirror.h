@@ -0,0 +1,282 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+#pragma once
+#include <fep_system/fep_system.h>
+#include "participant_registry.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fep3
+{
+    /**
+     * @brief Last known states of the participants of a system.
+     * The mirror is updated only by the states the participants confirmed to the system, which are the results
+     * of the transitions and state requests of the system and of the reconciliations (full state requests).
+     * It counts the participants per state, so the aggregated state is determined without visiting the participants.
+     * The state of a participant is unknown until it was learned once after the participant was added.
+     * Every change of the mirror is signalled to the threads waiting within waitForChange.
+     */
+    class SystemStateMirror
+    {
+    public:
+        SystemStateMirror() = default;
+        SystemStateMirror(const SystemStateMirror&) = delete;
+        SystemStateMirror& operator=(const SystemStateMirror&) = delete;
+
+        void addParticipant(const ParticipantProxy& participant)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            const auto participant_name = participant.getName();
+            if (_entries.emplace(participant_name, Entry()).second)
+            {
+                _participants.add(participant_name, participant);
+                ++_unknown_count;
+                changed();
+            }
+        }
+
+        void removeParticipant(const std::string& participant_name)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            auto found = _entries.find(participant_name);
+            if (found == _entries.end())
+            {
+                return;
+            }
+            forget(found->second);
+            _entries.erase(found);
+            _participants.remove(participant_name);
+            changed();
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            _entries.clear();
+            _participants.clear();
+            _counts.fill(0);
+            _unknown_count = 0;
+            _reconciled = false;
+            changed();
+        }
+
+        ///the participants of the mirror, used for reconciliations from threads other than the one of the system
+        std::vector<ParticipantProxy> getParticipants() const
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            return _participants.getOrdered();
+        }
+
+        bool hasParticipant(const std::string& participant_name) const
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            return _entries.find(participant_name) != _entries.end();
+        }
+
+        ///sets the state of one participant, participants which are not part of the mirror are ignored
+        void update(const std::string& participant_name, SystemAggregatedState state)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            auto found = _entries.find(participant_name);
+            if (found != _entries.end())
+            {
+                set(found->second, state);
+            }
+        }
+
+        /**
+         * Sets the result of a state request of all participants which was started at @p request_time,
+         * @p states and @p answered are in order of @p participants.
+         * The participants which did not answer in time keep their last known state.
+         * The staleness is measured from @p request_time if every participant answered
+         * and every participant of the mirror is known afterwards.
+         */
+        void reconcile(const std::vector<ParticipantProxy>& participants,
+            const std::vector<SystemAggregatedState>& states,
+            const std::vector<bool>& answered,
+            std::chrono::steady_clock::time_point request_time)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            bool all_answered = true;
+            for (size_t index = 0; index < participants.size() && index < states.size(); ++index)
+            {
+                if (index < answered.size() && !answered[index])
+                {
+                    all_answered = false;
+                    continue;
+                }
+                auto found = _entries.find(participants[index].getName());
+                if (found != _entries.end())
+                {
+                    set(found->second, states[index]);
+                }
+            }
+            if (all_answered && _unknown_count == 0)
+            {
+                _reconciled = true;
+                _reconciled_at = request_time;
+            }
+        }
+
+        /**
+         * Gets the last known state of one participant.
+         *
+         * @param[in] participant_name the name of the participant
+         * @param[out] state the state of the participant
+         * @return false if the participant is not part of the mirror or its state is unknown (@p state is not set)
+         */
+        bool getState(const std::string& participant_name, SystemAggregatedState& state) const
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            auto found = _entries.find(participant_name);
+            if (found == _entries.end() || !found->second._known)
+            {
+                return false;
+            }
+            state = found->second._state;
+            return true;
+        }
+
+        /**
+         * Gets the aggregated state like System::getSystemState from the counters.
+         *
+         * @param[out] state the aggregated state
+         * @return false if the state of at least one participant is unknown (@p state is not set)
+         */
+        bool getState(SystemState& state) const
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            if (_unknown_count != 0)
+            {
+                return false;
+            }
+            if (_entries.empty())
+            {
+                state = SystemState(SystemAggregatedState::undefined);
+                return true;
+            }
+            //participants which are undefined are not considered,
+            //if all of them are undefined the state is the highest one (as the aggregation of the states does)
+            const auto defined_count = _entries.size() - _counts[SystemAggregatedState::undefined];
+            state = SystemState(SystemAggregatedState::running);
+            for (size_t index = SystemAggregatedState::undefined + 1; index < _counts.size(); ++index)
+            {
+                if (_counts[index] != 0)
+                {
+                    state = SystemState(_counts[index] == defined_count, static_cast<SystemAggregatedState>(index));
+                    break;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Gets the time since the last reconciliation of all participants.
+         * Every state of the mirror is at least as recent as this, states pushed by the participants are younger.
+         *
+         * @return the staleness bound, std::chrono::milliseconds::max() if there was no reconciliation yet
+         */
+        std::chrono::milliseconds getStaleness() const
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            if (!_reconciled)
+            {
+                return std::chrono::milliseconds::max();
+            }
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - _reconciled_at);
+        }
+
+        ///the count of changes of the mirror so far
+        uint64_t getVersion() const
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            return _version;
+        }
+
+        /**
+         * Blocks until the mirror is changed after @p version (see getVersion) or @p until is reached.
+         *
+         * @return true if changed, false if timed out
+         */
+        bool waitForChange(uint64_t version, std::chrono::steady_clock::time_point until) const
+        {
+            std::unique_lock<std::mutex> lock(_sync);
+            return _changed.wait_until(lock, until, [this, version]() { return _version != version; });
+        }
+
+    private:
+        struct Entry
+        {
+            bool _known = false;
+            SystemAggregatedState _state = SystemAggregatedState::undefined;
+        };
+
+        void set(Entry& entry, SystemAggregatedState state)
+        {
+            if (entry._known && entry._state == state)
+            {
+                return;
+            }
+            forget(entry);
+            entry._known = true;
+            entry._state = state;
+            ++_counts[state];
+            changed();
+        }
+
+        void changed()
+        {
+            ++_version;
+            _changed.notify_all();
+        }
+
+        void forget(Entry& entry)
+        {
+            if (entry._known)
+            {
+                --_counts[entry._state];
+            }
+            else
+            {
+                --_unknown_count;
+            }
+        }
+
+        std::map<std::string, Entry> _entries;
+        ParticipantRegistry _participants;
+        ///count of the known participants per state
+        std::array<size_t, SystemAggregatedState::running + 1> _counts{};
+        size_t _unknown_count{ 0 };
+        bool _reconciled{ false };
+        std::chrono::steady_clock::time_point _reconciled_at;
+        uint64_t _version{ 0 };
+        mutable std::mutex _sync;
+        mutable std::condition_variable _changed;
+    };
+}
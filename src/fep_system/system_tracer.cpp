@@ -0,0 +1,213 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+
+#include "system_tracer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <utility>
+
+namespace fep3
+{
+namespace
+{
+    std::string escape(const std::string& value)
+    {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (const auto character : value)
+        {
+            switch (character)
+            {
+                case '"':
+                    escaped += "\\\"";
+                    break;
+                case '\\':
+                    escaped += "\\\\";
+                    break;
+                case '\n':
+                    escaped += "\\n";
+                    break;
+                case '\r':
+                    escaped += "\\r";
+                    break;
+                case '\t':
+                    escaped += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(character) < 0x20)
+                    {
+                        char code[8];
+                        std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(character));
+                        escaped += code;
+                    }
+                    else
+                    {
+                        escaped += character;
+                    }
+                    break;
+            }
+        }
+        return escaped;
+    }
+
+    std::string getMetadata(const std::string& name, size_t pid, size_t tid, const std::string& args)
+    {
+        return "{\"name\":\"" + name + "\",\"ph\":\"M\",\"pid\":" + std::to_string(pid)
+            + ",\"tid\":" + std::to_string(tid) + ",\"args\":{" + args + "}}";
+    }
+
+    int64_t toMicroseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+}
+
+constexpr const char* const SystemTracer::operation;
+constexpr const char* const SystemTracer::call;
+
+SystemTracer& SystemTracer::get()
+{
+    static SystemTracer tracer;
+    return tracer;
+}
+
+void SystemTracer::start(size_t max_event_count)
+{
+    std::lock_guard<std::mutex> lock(_sync);
+    _events.clear();
+    _max_event_count = max_event_count;
+    _dropped_event_count = 0;
+    _start_time = Clock::now();
+    _enabled = true;
+}
+
+void SystemTracer::stop()
+{
+    _enabled = false;
+}
+
+void SystemTracer::record(const char* category,
+    const std::string& name,
+    const std::string& system_name,
+    const std::string& participant_name,
+    Clock::time_point begin,
+    Clock::time_point end,
+    bool successful)
+{
+    if (!_enabled)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_sync);
+    //events which began before the start belong to the previous trace
+    if (begin < _start_time)
+    {
+        return;
+    }
+    if (_events.size() >= _max_event_count)
+    {
+        ++_dropped_event_count;
+        return;
+    }
+    _events.push_back({ category, name, system_name, participant_name, begin, end, successful });
+}
+
+std::string SystemTracer::getJson() const
+{
+    std::vector<Event> events;
+    uint64_t dropped_event_count = 0;
+    Clock::time_point start_time;
+    {
+        std::lock_guard<std::mutex> lock(_sync);
+        events = _events;
+        dropped_event_count = _dropped_event_count;
+        start_time = _start_time;
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Event& first, const Event& second)
+    {
+        return first._begin < second._begin;
+    });
+
+    //the events of one lane (thread) of the trace must not overlap, so overlapping events
+    //of the same participant (i.e. a state request within a transition) get additional lanes
+    struct Lane
+    {
+        size_t _tid;
+        Clock::time_point _end;
+    };
+    std::map<std::string, size_t> pids;
+    std::map<size_t, size_t> tid_counts;
+    std::map<std::pair<std::string, std::string>, std::vector<Lane>> lanes;
+    std::vector<std::string> trace_events;
+    for (const auto& event : events)
+    {
+        auto pid = pids.find(event._system_name);
+        if (pid == pids.end())
+        {
+            pid = pids.emplace(event._system_name, pids.size() + 1).first;
+            trace_events.push_back(getMetadata("process_name", pid->second, 0, "\"name\":\""
+                + (event._system_name.empty() ? std::string("discovery") : "system " + escape(event._system_name))
+                + "\""));
+        }
+        auto& participant_lanes = lanes[std::make_pair(event._system_name, event._participant_name)];
+        auto lane = std::find_if(participant_lanes.begin(), participant_lanes.end(), [&event](const Lane& used_lane)
+        {
+            return used_lane._end <= event._begin;
+        });
+        if (lane == participant_lanes.end())
+        {
+            const auto tid = ++tid_counts[pid->second];
+            auto lane_name = event._participant_name.empty() ? std::string("operations") : escape(event._participant_name);
+            if (!participant_lanes.empty())
+            {
+                lane_name += " (" + std::to_string(participant_lanes.size() + 1) + ")";
+            }
+            trace_events.push_back(getMetadata("thread_name", pid->second, tid, "\"name\":\"" + lane_name + "\""));
+            trace_events.push_back(getMetadata("thread_sort_index", pid->second, tid,
+                "\"sort_index\":" + std::to_string(tid)));
+            participant_lanes.push_back({ tid, event._end });
+            lane = participant_lanes.end() - 1;
+        }
+        else
+        {
+            lane->_end = event._end;
+        }
+        trace_events.push_back("{\"name\":\"" + escape(event._name)
+            + "\",\"cat\":\"" + event._category
+            + "\",\"ph\":\"X\",\"ts\":" + std::to_string(toMicroseconds(event._begin - start_time))
+            + ",\"dur\":" + std::to_string(toMicroseconds(event._end - event._begin))
+            + ",\"pid\":" + std::to_string(pid->second)
+            + ",\"tid\":" + std::to_string(lane->_tid)
+            + ",\"args\":{\"successful\":" + (event._successful ? "true" : "false") + "}}");
+    }
+
+    std::string json = "{\"traceEvents\":[";
+    for (size_t index = 0; index < trace_events.size(); ++index)
+    {
+        json += (index == 0 ? "\n" : ",\n") + trace_events[index];
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":\""
+        + std::to_string(dropped_event_count) + "\"}}\n";
+    return json;
+}
+}
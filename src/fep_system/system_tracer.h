@@ -0,0 +1,145 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fep3
+{
+    /**
+     * @brief Records the system operations and the calls of the participants within them of the whole process
+     * while tracing is enabled (see fep3::startTracing) and renders them as Chrome trace JSON.
+     * Every system is one process of the trace, the participants are its threads.
+     * Recording is thread safe, if tracing is disabled it costs one atomic check.
+     */
+    class SystemTracer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        ///a system operation (i.e. a transition), a property fan-out or the discovery
+        static constexpr const char* const operation = "operation";
+        ///one call of one participant
+        static constexpr const char* const call = "call";
+
+        static SystemTracer& get();
+
+        SystemTracer(const SystemTracer&) = delete;
+        SystemTracer& operator=(const SystemTracer&) = delete;
+
+        ///drops the recorded events and starts recording up to @p max_event_count events
+        void start(size_t max_event_count);
+        void stop();
+
+        bool isEnabled() const
+        {
+            return _enabled;
+        }
+
+        ///records one event, empty @p participant_name for the events of the system itself
+        void record(const char* category,
+            const std::string& name,
+            const std::string& system_name,
+            const std::string& participant_name,
+            Clock::time_point begin,
+            Clock::time_point end,
+            bool successful);
+
+        ///the recorded events as Chrome trace JSON (object format)
+        std::string getJson() const;
+
+    private:
+        SystemTracer() = default;
+
+        struct Event
+        {
+            const char* _category;
+            std::string _name;
+            std::string _system_name;
+            std::string _participant_name;
+            Clock::time_point _begin;
+            Clock::time_point _end;
+            bool _successful;
+        };
+
+        std::atomic<bool> _enabled{ false };
+        std::vector<Event> _events;
+        size_t _max_event_count{ 0 };
+        uint64_t _dropped_event_count{ 0 };
+        Clock::time_point _start_time;
+        mutable std::mutex _sync;
+    };
+
+    /**
+     * @brief Records the lifetime of the scope as one event if tracing is enabled at its begin.
+     * The event is failed unless @ref setSuccessful is called, so a scope left by an exception is failed.
+     */
+    class TraceScope
+    {
+    public:
+        TraceScope(const char* category,
+            const std::string& name,
+            const std::string& system_name,
+            const std::string& participant_name = std::string())
+            : _enabled(SystemTracer::get().isEnabled())
+        {
+            if (_enabled)
+            {
+                _category = category;
+                _name = name;
+                _system_name = system_name;
+                _participant_name = participant_name;
+                _begin = SystemTracer::Clock::now();
+            }
+        }
+
+        ~TraceScope()
+        {
+            if (_enabled)
+            {
+                SystemTracer::get().record(_category, _name, _system_name, _participant_name,
+                    _begin, SystemTracer::Clock::now(), _successful);
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+        void setSuccessful()
+        {
+            _successful = true;
+        }
+
+    private:
+        const bool _enabled;
+        const char* _category = nullptr;
+        std::string _name;
+        std::string _system_name;
+        std::string _participant_name;
+        SystemTracer::Clock::time_point _begin;
+        bool _successful = false;
+    };
+}
@@ -0,0 +1,152 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+
+#pragma once
+#include "private_system_operation.hpp"
+#include "system_logger.h"
+#include "worker_pool.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fep3
+{
+    /**
+     * @brief Reports the progress of the transitions of one system operation to the IEventMonitor of the system
+     * (see IEventMonitor::onTransitionStarted).
+     * The events are delivered by the given pool (one worker keeps them in order), so a slow monitor
+     * does not delay the operation.
+     * The operation calls the reporter one call at a time, so it needs no synchronization of its own.
+     */
+    class TransitionProgressReporter : public SystemOperation::Implementation::ProgressObserver
+    {
+    public:
+        TransitionProgressReporter(const std::shared_ptr<SystemLogger>& logger,
+            const std::shared_ptr<WorkerPool>& delivery,
+            const std::vector<ParticipantProxy>& participants)
+            : _logger(logger),
+              _delivery(delivery)
+        {
+            for (const auto& participant : participants)
+            {
+                _participant_names.push_back(participant.getName());
+            }
+        }
+
+        void onPhaseStarted(const std::vector<std::string>& call_names) override
+        {
+            _call_names = call_names;
+            _transitions.clear();
+            _phase_begin = std::chrono::steady_clock::now();
+            for (const auto& call_name : _call_names)
+            {
+                if (!call_name.empty())
+                {
+                    ++_transitions[call_name]._participant_count;
+                }
+            }
+            for (const auto& transition : _transitions)
+            {
+                const auto transition_name = transition.first;
+                const auto participant_count = transition.second._participant_count;
+                post([transition_name, participant_count](IEventMonitor& monitor)
+                {
+                    monitor.onTransitionStarted(transition_name, participant_count);
+                });
+            }
+        }
+
+        void onCallFinished(size_t participant_index,
+            ParticipantProgress::Status status,
+            std::chrono::steady_clock::duration duration) override
+        {
+            const auto transition_name = _call_names[participant_index];
+            auto& transition = _transitions[transition_name];
+            ++transition._finished_count;
+            const bool successful = (status == ParticipantProgress::Status::done);
+            if (!successful)
+            {
+                ++transition._failed_count;
+            }
+            const auto participant_name = _participant_names[participant_index];
+            const auto finished_count = transition._finished_count;
+            const auto participant_count = transition._participant_count;
+            const auto call_duration = std::chrono::duration_cast<std::chrono::microseconds>(duration);
+            post([transition_name, participant_name, successful, call_duration, finished_count, participant_count](
+                IEventMonitor& monitor)
+            {
+                monitor.onParticipantTransitionFinished(transition_name, participant_name, successful,
+                    call_duration, finished_count, participant_count);
+            });
+        }
+
+        void onPhaseFinished() override
+        {
+            const auto phase_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - _phase_begin);
+            for (const auto& transition : _transitions)
+            {
+                const auto transition_name = transition.first;
+                //participants which were not called (i.e. the operation was cancelled) did not change their state
+                const bool successful = transition.second._failed_count == 0
+                    && transition.second._finished_count == transition.second._participant_count;
+                post([transition_name, successful, phase_duration](IEventMonitor& monitor)
+                {
+                    monitor.onTransitionFinished(transition_name, successful, phase_duration);
+                });
+            }
+            _transitions.clear();
+        }
+
+    private:
+        struct Progress
+        {
+            size_t _participant_count = 0;
+            size_t _finished_count = 0;
+            size_t _failed_count = 0;
+        };
+
+        void post(std::function<void(IEventMonitor&)> event)
+        {
+            if (!_logger->hasMonitor())
+            {
+                return;
+            }
+            auto logger = _logger;
+            _delivery->post([logger, event]()
+            {
+                logger->notifyMonitor(event);
+            });
+        }
+
+        const std::shared_ptr<SystemLogger> _logger;
+        const std::shared_ptr<WorkerPool> _delivery;
+        std::vector<std::string> _participant_names;
+        ///call names of the current phase by participant index
+        std::vector<std::string> _call_names;
+        std::map<std::string, Progress> _transitions;
+        std::chrono::steady_clock::time_point _phase_begin;
+    };
+}
@@ -0,0 +1,257 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fep3
+{
+    /**
+     * @brief Pool of worker threads used to fan out RPC calls to the participants of a system.
+     * Threads are created on demand (if no idle worker is available) up to the given maximum
+     * and are kept alive until the pool is destroyed.
+     * Tasks which are posted while all workers are busy are queued.
+     * A running task which was abandoned by its poster (see postAbandonable) is not counted against the maximum,
+     * so tasks blocked by hung participants do not stall the following ones. The pool keeps at most
+     * the maximum plus the highest count of abandoned tasks running at the same time.
+     * Timers (see postAt) are served by one additional thread which is created with the first timer.
+     */
+    class WorkerPool
+    {
+    public:
+        explicit WorkerPool(size_t max_worker_count)
+            : _max_worker_count(std::max<size_t>(1, max_worker_count))
+        {
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_sync);
+                _stopped = true;
+            }
+            _task_available.notify_all();
+            _timer_due.notify_all();
+            for (auto& worker : _workers)
+            {
+                worker.join();
+            }
+            if (_timer.joinable())
+            {
+                _timer.join();
+            }
+        }
+
+        void post(std::function<void()> task)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            _tasks.push_back(std::move(task));
+            startWorkerIfNeeded();
+            _task_available.notify_one();
+        }
+
+        ///state of a task posted by postAbandonable, only accessed by the pool
+        class Task
+        {
+            friend class WorkerPool;
+            bool _running = false;
+            bool _abandoned = false;
+        };
+
+        ///posts @p task like post, the poster may abandon it (see abandon)
+        std::shared_ptr<Task> postAbandonable(std::function<void()> task)
+        {
+            auto state = std::make_shared<Task>();
+            post([this, state, task]()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_sync);
+                    if (state->_abandoned)
+                    {
+                        //nobody waits for it anymore
+                        return;
+                    }
+                    state->_running = true;
+                }
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                }
+                std::lock_guard<std::mutex> lock(_sync);
+                state->_running = false;
+                if (state->_abandoned)
+                {
+                    --_abandoned_count;
+                }
+            });
+            return state;
+        }
+
+        /**
+         * The poster does not wait for @p task anymore (i.e. its participant missed the deadline).
+         * A task which did not start yet is not run at all, a running one is not counted against the maximum
+         * count of workers until it returns, so another worker may be started for the queued tasks.
+         */
+        void abandon(const std::shared_ptr<Task>& task)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            if (!task || task->_abandoned)
+            {
+                return;
+            }
+            task->_abandoned = true;
+            if (task->_running)
+            {
+                ++_abandoned_count;
+                startWorkerIfNeeded();
+            }
+        }
+
+        template<typename Callable>
+        auto submit(Callable&& call) -> std::future<decltype(call())>
+        {
+            using ResultType = decltype(call());
+            auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Callable>(call));
+            auto result = task->get_future();
+            post([task]() { (*task)(); });
+            return result;
+        }
+
+        /**
+         * Calls @p task at @p due_time within the timer thread.
+         * Timers which are not due while the pool is destroyed (or posted afterwards) are dropped.
+         * @remark The task must not block, it delays all other timers.
+         */
+        void postAt(std::chrono::steady_clock::time_point due_time, std::function<void()> task)
+        {
+            std::lock_guard<std::mutex> lock(_sync);
+            if (_stopped)
+            {
+                return;
+            }
+            _timers.emplace(due_time, std::move(task));
+            if (!_timer.joinable())
+            {
+                _timer = std::thread([this]() { serveTimers(); });
+            }
+            _timer_due.notify_one();
+        }
+
+    private:
+        ///starts a worker if the queued tasks exceed the idle workers, the lock must be held
+        void startWorkerIfNeeded()
+        {
+            //while the pool is destroyed the remaining workers finish the queue, no new ones are joined
+            if (!_stopped
+                && _idle_worker_count < _tasks.size()
+                && _workers.size() < _max_worker_count + _abandoned_count)
+            {
+                _workers.emplace_back([this]() { work(); });
+            }
+        }
+
+        void serveTimers()
+        {
+            std::unique_lock<std::mutex> lock(_sync);
+            while (!_stopped)
+            {
+                if (_timers.empty())
+                {
+                    _timer_due.wait(lock);
+                    continue;
+                }
+                auto next_timer = _timers.begin();
+                if (std::chrono::steady_clock::now() < next_timer->first)
+                {
+                    _timer_due.wait_until(lock, next_timer->first);
+                    continue;
+                }
+                auto task = std::move(next_timer->second);
+                _timers.erase(next_timer);
+                lock.unlock();
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                }
+                lock.lock();
+            }
+        }
+
+        void work()
+        {
+            std::unique_lock<std::mutex> lock(_sync);
+            while (true)
+            {
+                ++_idle_worker_count;
+                _task_available.wait(lock, [this]() { return _stopped || !_tasks.empty(); });
+                --_idle_worker_count;
+                if (_tasks.empty())
+                {
+                    //stopped and nothing left to do
+                    return;
+                }
+                auto task = std::move(_tasks.front());
+                _tasks.pop_front();
+                lock.unlock();
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                    //tasks report their errors by themselves (see submit), a worker must not die
+                }
+                lock.lock();
+            }
+        }
+
+        const size_t _max_worker_count;
+        size_t _idle_worker_count{ 0 };
+        ///count of the running tasks which were abandoned (see abandon)
+        size_t _abandoned_count{ 0 };
+        bool _stopped{ false };
+        std::deque<std::function<void()>> _tasks;
+        std::vector<std::thread> _workers;
+        std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> _timers;
+        std::thread _timer;
+        std::mutex _sync;
+        std::condition_variable _task_available;
+        std::condition_variable _timer_due;
+    };
+}
@@ -138,6 +138,7 @@ using TestParticipants = std::map<std::string, std::unique_ptr<PartStruct>>;
 * @brief Creates modules from the incoming list of names
 *
 */
+template<typename Element = TestElement>
 inline TestParticipants createTestParticipants(
     const std::vector<std::string>& participant_names,
     const std::string& system_name)
@@ -149,7 +150,7 @@ inline TestParticipants createTestParticipants(
         , participant_names.end()
         , [&](const std::string& name)
             {
-                auto part = createParticipant<ElementFactory<TestElement>>(name, "1.0", system_name);
+                auto part = createParticipant<ElementFactory<Element>>(name, "1.0", system_name);
                 auto part_exec = std::make_unique<PartStruct>(std::move(part));
                 part_exec->_part_executor.exec();
                 test_parts[name].reset(part_exec.release());
@@ -0,0 +1,95 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include "fep_system/participant_registry.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const size_t participant_count = 10000;
+
+    std::vector<std::string> getParticipantNames(size_t count)
+    {
+        std::vector<std::string> participant_names;
+        for (size_t index = 0; index < count; ++index)
+        {
+            participant_names.push_back("participant_" + std::to_string(index));
+        }
+        return participant_names;
+    }
+
+    void report(const std::string& key, double value)
+    {
+        std::cout << key << ": " << value << std::endl;
+        ::testing::Test::RecordProperty(key, std::to_string(value));
+    }
+
+    double getMicroseconds(std::chrono::steady_clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+/**
+ * @detail Adds, looks up and removes 10k participants like fep3::System does and reports the time of one operation.
+ * The proxies are not connected, so only the registry itself is measured.
+ */
+TEST(ParticipantRegistryBenchmark, AddFindRemove)
+{
+    const auto participant_names = getParticipantNames(participant_count);
+    fep3::ParticipantRegistry registry;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& participant_name : participant_names)
+    {
+        ASSERT_TRUE(registry.add(participant_name, fep3::ParticipantProxy()));
+    }
+    report("add_us_per_participant", getMicroseconds(begin) / participant_count);
+    ASSERT_EQ(registry.size(), participant_count);
+    ASSERT_FALSE(registry.add(participant_names.front(), fep3::ParticipantProxy()));
+
+    begin = std::chrono::steady_clock::now();
+    for (const auto& participant_name : participant_names)
+    {
+        ASSERT_NE(registry.find(participant_name), nullptr);
+    }
+    report("find_us_per_participant", getMicroseconds(begin) / participant_count);
+    ASSERT_EQ(registry.find("participant_unknown"), nullptr);
+
+    begin = std::chrono::steady_clock::now();
+    ASSERT_EQ(registry.getOrdered().size(), participant_count);
+    report("ordered_us", getMicroseconds(begin));
+
+    //removing in order of the addition is the worst case of a vector
+    begin = std::chrono::steady_clock::now();
+    for (const auto& participant_name : participant_names)
+    {
+        ASSERT_TRUE(registry.remove(participant_name));
+    }
+    report("remove_us_per_participant", getMicroseconds(begin) / participant_count);
+    EXPECT_TRUE(registry.empty());
+    EXPECT_FALSE(registry.remove(participant_names.front()));
+}
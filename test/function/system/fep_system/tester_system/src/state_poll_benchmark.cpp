@@ -0,0 +1,218 @@
+/**
+ * @file
+
+   @copyright
+   @verbatim
+   Copyright @ 2020 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <fep_system/fep_system.h>
+#include <fep_system/rpc_services/participant_statemachine/participant_statemachine_rpc_intf.h>
+#include <fep3/components/service_bus/service_bus_intf.h>
+#include <fep3/components/service_bus/rpc/fep_rpc.h>
+#include "test_stubs/participant_statemachine_service_stub.h"
+#include "fep_test_common.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+    //allocations of the whole process, including the worker threads doing the RPCs and the participants answering them
+    std::atomic<uint64_t> process_allocation_count{ 0 };
+    //allocations of the thread polling the states while counting is enabled on it
+    thread_local bool count_thread_allocations = false;
+    thread_local uint64_t thread_allocation_count = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++process_allocation_count;
+    if (count_thread_allocations)
+    {
+        ++thread_allocation_count;
+    }
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    const size_t participant_count = 10;
+    //the dashboard rate is 10 Hz, so these are 10 seconds of polling
+    const size_t poll_count = 100;
+    //the polling thread creates the operation and posts one call per participant,
+    //the RPCs themselves are done by the worker threads.
+    //A poll measured 37 allocations plus 11 to 12 per participant, the bounds are just above.
+    const size_t max_thread_allocations_per_poll = 40;
+    const size_t max_thread_allocations_per_participant = 13;
+
+    using StateMachineService = fep3::rpc::RPCService<fep3::rpc_proxy_stub::RPCStateMachineService,
+        fep3::rpc::IRPCParticipantStateMachineDef>;
+
+    /**
+     * State machine service of a participant which is polled only, it counts the state requests it answers.
+     * Every transition is denied.
+     */
+    class CountingStateMachineService : public StateMachineService
+    {
+    public:
+        std::string getCurrentStateName() override
+        {
+            ++_state_requests;
+            return "Unloaded";
+        }
+        bool load() override { return false; }
+        bool unload() override { return false; }
+        bool initialize() override { return false; }
+        bool deinitialize() override { return false; }
+        bool start() override { return false; }
+        bool pause() override { return false; }
+        bool stop() override { return false; }
+        bool exit() override { return false; }
+
+        uint64_t getStateRequestCount() const
+        {
+            return _state_requests;
+        }
+
+    private:
+        std::atomic<uint64_t> _state_requests{ 0 };
+    };
+
+    using StateRequestCounters = std::vector<std::shared_ptr<CountingStateMachineService>>;
+
+    std::vector<std::string> getParticipantNames()
+    {
+        std::vector<std::string> participant_names;
+        for (size_t index = 0; index < participant_count; ++index)
+        {
+            participant_names.push_back("participant_" + std::to_string(index));
+        }
+        return participant_names;
+    }
+
+    ///replaces the state machine service of every test participant by a counting one
+    StateRequestCounters countStateRequests(TestParticipants& test_parts)
+    {
+        const auto service_name = fep3::rpc::IRPCParticipantStateMachineDef::getRPCDefaultName();
+        StateRequestCounters counters;
+        for (auto& test_part : test_parts)
+        {
+            auto server = test_part.second->_part.getComponent<fep3::IServiceBus>()->getServer();
+            auto counter = std::make_shared<CountingStateMachineService>();
+            EXPECT_FALSE(fep3::isFailed(server->unregisterService(service_name)));
+            EXPECT_FALSE(fep3::isFailed(server->registerService(service_name, counter)));
+            counters.push_back(counter);
+        }
+        return counters;
+    }
+
+    uint64_t getStateRequestCount(const StateRequestCounters& counters)
+    {
+        uint64_t state_requests = 0;
+        for (const auto& counter : counters)
+        {
+            state_requests += counter->getStateRequestCount();
+        }
+        return state_requests;
+    }
+
+    void report(const std::string& key, double value)
+    {
+        std::cout << key << ": " << value << std::endl;
+        ::testing::Test::RecordProperty(key, std::to_string(value));
+    }
+}
+
+/**
+ * @detail Polls the state of a system like a dashboard does and reports the allocations of one poll.
+ * The allocations of the polling thread are checked against a bound, the ones of the whole process
+ * (the transport of the RPCs and the participants of this process) are reported only.
+ */
+TEST(StatePollBenchmark, AllocationsPerPoll)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const auto participant_names = getParticipantNames();
+    auto test_parts = createTestParticipants(participant_names, sys_name);
+    fep3::System my_sys(sys_name);
+    for (const auto& participant_name : participant_names)
+    {
+        my_sys.add(participant_name);
+    }
+    //the first poll looks up the state machines of the participants
+    ASSERT_EQ(my_sys.getSystemState()._state, fep3::System::AggregatedState::unloaded);
+
+    const auto process_allocations_before = process_allocation_count.load();
+    thread_allocation_count = 0;
+    count_thread_allocations = true;
+    for (size_t poll = 0; poll < poll_count; ++poll)
+    {
+        ASSERT_EQ(my_sys.getSystemState()._state, fep3::System::AggregatedState::unloaded);
+    }
+    count_thread_allocations = false;
+    const auto thread_allocations = static_cast<double>(thread_allocation_count);
+    const auto process_allocations = static_cast<double>(process_allocation_count.load() - process_allocations_before);
+
+    report("thread_allocations_per_poll", thread_allocations / poll_count);
+    report("process_allocations_per_poll", process_allocations / poll_count);
+    report("process_allocations_per_participant_and_poll", process_allocations / (poll_count * participant_count));
+    EXPECT_LE(thread_allocations / poll_count,
+        max_thread_allocations_per_poll + max_thread_allocations_per_participant * participant_count);
+}
+
+/**
+ * @detail Polls the state of a system like a dashboard does and checks by the participants that every poll
+ * is one state RPC per participant, the state machines are looked up by the first poll only.
+ */
+TEST(StatePollBenchmark, RPCsPerPoll)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const auto participant_names = getParticipantNames();
+    auto test_parts = createTestParticipants(participant_names, sys_name);
+    const auto counters = countStateRequests(test_parts);
+    fep3::System my_sys(sys_name);
+    for (const auto& participant_name : participant_names)
+    {
+        my_sys.add(participant_name);
+    }
+    //the first poll looks up the state machines of the participants
+    ASSERT_EQ(my_sys.getSystemState()._state, fep3::System::AggregatedState::unloaded);
+
+    const auto state_requests_before = getStateRequestCount(counters);
+    for (size_t poll = 0; poll < poll_count; ++poll)
+    {
+        ASSERT_EQ(my_sys.getSystemState()._state, fep3::System::AggregatedState::unloaded);
+    }
+    const auto state_requests = getStateRequestCount(counters) - state_requests_before;
+    EXPECT_EQ(state_requests, participant_count * poll_count);
+    report("state_rpcs_per_poll", static_cast<double>(state_requests) / poll_count);
+}
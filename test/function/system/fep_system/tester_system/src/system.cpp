@@ -34,6 +34,10 @@
 #include <gtest/gtest.h>
 #include <fep_system/fep_system.h>
 #include <string.h>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <map>
 #include "fep_test_common.h"
 #include <a_util/logging.h>
 #include <a_util/process.h>
@@ -247,6 +251,30 @@ public:
         return (current_message_final.find(message) != std::string::npos);
     }
 
+    void onParticipantReachabilityChanged(const std::string& participant_name, bool reachable) override
+    {
+        std::unique_lock<std::mutex> lk(_cv_m);
+        _reachability[participant_name] = reachable;
+    }
+
+    bool waitForReachability(const std::string& participant_name, bool reachable, timestamp_t timeout_ms = 4000)
+    {
+        auto begin_time = a_util::system::getCurrentMilliseconds();
+        while (timeout_ms > (a_util::system::getCurrentMilliseconds() - begin_time))
+        {
+            {
+                std::unique_lock<std::mutex> lk(_cv_m);
+                auto found = _reachability.find(participant_name);
+                if (found != _reachability.end() && found->second == reachable)
+                {
+                    return true;
+                }
+            }
+            a_util::system::sleepMilliseconds(static_cast<uint32_t>(timeout_ms / 10));
+        }
+        return false;
+    }
+
     fep3::logging::Category _category;
     fep3::logging::Severity _severity_level;
     std::string _participant_name;
@@ -256,6 +284,7 @@ public:
     std::string _new_name;
     std::string _logger_name_filter;
 private:
+    std::map<std::string, bool> _reachability;
     std::mutex _cv_m;
     std::atomic_bool _done{ false };
 };
@@ -455,6 +484,457 @@ TEST(SystemLibrary, TestControlSystemNOK)
     }
 }
 
+TEST(SystemLibrary, TestControlSystemPreflightCheckNOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1 };
+    const auto test_parts = createTestParticipants(participant_names, sys_name);
+
+    {
+        fep3::System my_sys(sys_name);
+        my_sys.add(part_name_1);
+        my_sys.add("does_not_exist");
+        ASSERT_FALSE(my_sys.getPreflightCheck());
+        my_sys.setPreflightCheck(true, std::chrono::milliseconds(500));
+        ASSERT_TRUE(my_sys.getPreflightCheck());
+
+        // the transition is aborted before any participant is called
+        bool caught = false;
+        try
+        {
+            my_sys.load();
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::string msg = e.what();
+            ASSERT_EQ(msg, "Participants does_not_exist are unreachable, load of system " + sys_name + " aborted");
+            caught = true;
+        }
+        ASSERT_TRUE(caught);
+        auto state = my_sys.getParticipant(part_name_1).getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->getState();
+        ASSERT_EQ(state, fep3::rpc::ParticipantState::unloaded);
+
+        my_sys.remove("does_not_exist");
+        my_sys.load();
+        my_sys.unload();
+    }
+}
+
+TEST(SystemLibrary, TestControlSystemIdempotentOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1, part_name_2 };
+    const auto test_parts = createTestParticipants(participant_names, sys_name);
+
+    {
+        fep3::System my_sys(sys_name);
+        my_sys.add(part_name_1);
+        my_sys.add(part_name_2);
+        my_sys.load();
+
+        // participant1 is initialized already, so it declines the initialize
+        auto p1 = my_sys.getParticipant(part_name_1);
+        p1.getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->initialize();
+        ASSERT_ANY_THROW(my_sys.initialize());
+        my_sys.getParticipant(part_name_2).getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->deinitialize();
+
+        // participant1 is not called at all
+        ASSERT_FALSE(my_sys.getIdempotentTransitions());
+        my_sys.setIdempotentTransitions(true);
+        ASSERT_TRUE(my_sys.getIdempotentTransitions());
+        auto operation = my_sys.initializeAsync();
+        ASSERT_NO_THROW(operation.get());
+        for (const auto& progress : operation.getParticipantProgress())
+        {
+            ASSERT_EQ(progress._status, fep3::ParticipantProgress::Status::done);
+        }
+        auto system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::initialized);
+
+        ASSERT_NO_THROW(my_sys.initialize());
+        my_sys.deinitialize();
+        my_sys.unload();
+        my_sys.shutdown();
+    }
+}
+
+TEST(SystemLibrary, TestSystemStateMirrorOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1, part_name_2 };
+    const auto test_parts = createTestParticipants(participant_names, sys_name);
+
+    {
+        fep3::System my_sys(sys_name);
+        my_sys.add(part_name_1);
+        my_sys.add(part_name_2);
+        ASSERT_FALSE(my_sys.getStateMirror());
+        ASSERT_EQ(my_sys.getStateStaleness(), std::chrono::milliseconds::max());
+
+        my_sys.setStateMirror(true, std::chrono::milliseconds(200));
+        ASSERT_TRUE(my_sys.getStateMirror());
+        // the transitions of the system update the mirror
+        my_sys.load();
+        auto system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::loaded);
+
+        // a state change behind the back of the system is found by the reconciliation
+        my_sys.getParticipant(part_name_2).getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->initialize();
+        a_util::system::sleepMilliseconds(1000);
+        ASSERT_LT(my_sys.getStateStaleness(), std::chrono::milliseconds(1000));
+        system_state = my_sys.getSystemState();
+        ASSERT_FALSE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::loaded);
+
+        // a mirror older than the maximum staleness is not used, the participants are requested
+        my_sys.setStateMirror(true, std::chrono::milliseconds(60000), std::chrono::milliseconds(100));
+        a_util::system::sleepMilliseconds(500);
+        my_sys.getParticipant(part_name_2).getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->deinitialize();
+        a_util::system::sleepMilliseconds(200);
+        system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::loaded);
+
+        my_sys.setStateMirror(false);
+        my_sys.unload();
+        my_sys.shutdown();
+    }
+}
+
+TEST(SystemLibrary, TestWaitForSystemStateOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1, part_name_2 };
+    const auto test_parts = createTestParticipants(participant_names, sys_name);
+
+    {
+        fep3::System my_sys(sys_name);
+        my_sys.add(part_name_1);
+        my_sys.add(part_name_2);
+
+        auto operation = my_sys.loadAsync();
+        ASSERT_TRUE(my_sys.waitForSystemState(fep3::SystemAggregatedState::loaded));
+        ASSERT_NO_THROW(operation.get());
+
+        my_sys.getParticipant(part_name_2).getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->initialize();
+        ASSERT_TRUE(my_sys.waitForParticipantState(part_name_2, fep3::SystemAggregatedState::initialized));
+        ASSERT_FALSE(my_sys.waitForSystemState(fep3::SystemAggregatedState::initialized, std::chrono::milliseconds(200)));
+        ASSERT_FALSE(my_sys.waitForParticipantState(part_name_1, fep3::SystemAggregatedState::running, std::chrono::milliseconds(200)));
+        ASSERT_ANY_THROW(my_sys.waitForParticipantState("unknown_participant", fep3::SystemAggregatedState::loaded));
+
+        my_sys.getParticipant(part_name_2).getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->deinitialize();
+        my_sys.unload();
+        my_sys.shutdown();
+    }
+}
+
+/**
+ * Element which counts the participants initializing at the same time
+ */
+struct ConcurrencyElement : public fep3::core::ElementBase
+{
+    ConcurrencyElement()
+        : fep3::core::ElementBase(makePlatformDepName("Concurrencyelement"), "3.0")
+    {
+    }
+
+    fep3::Result initialize() override
+    {
+        const auto running = ++getRunning();
+        auto max_running = getMaxRunning().load();
+        while (running > max_running && !getMaxRunning().compare_exchange_weak(max_running, running))
+        {
+        }
+        a_util::system::sleepMilliseconds(200);
+        --getRunning();
+        return {};
+    }
+
+    static std::atomic<int>& getRunning()
+    {
+        static std::atomic<int> running{ 0 };
+        return running;
+    }
+
+    static std::atomic<int>& getMaxRunning()
+    {
+        static std::atomic<int> max_running{ 0 };
+        return max_running;
+    }
+};
+
+TEST(SystemLibrary, TestControlSystemSamePriorityOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const auto participant_names = std::vector<std::string>{ "participant1", "participant2", "participant3", "participant4" };
+    const auto test_parts = createTestParticipants<ConcurrencyElement>(participant_names, sys_name);
+
+    {
+        // the participants are added with their urls, all of them are on this host
+        const auto discovered_sys = fep3::discoverSystem(sys_name);
+        fep3::System my_sys(sys_name);
+        for (const auto& part_name : participant_names)
+        {
+            const auto url = discovered_sys.getParticipant(part_name).getUrl();
+            ASSERT_FALSE(url.empty());
+            my_sys.add(part_name, url);
+        }
+        //participant4 is the only one on a different priority level
+        my_sys.getParticipant("participant4").setInitPriority(1);
+        my_sys.getParticipant("participant4").setStartPriority(1);
+        //participants of the same host are limited, the others are not
+        ASSERT_EQ(my_sys.getHostConcurrency(), 0u);
+        my_sys.setHostConcurrency(1);
+        ASSERT_EQ(my_sys.getHostConcurrency(), 1u);
+
+        // participants of one priority level on one host are called one after the other
+        ConcurrencyElement::getMaxRunning() = 0;
+        my_sys.load();
+        my_sys.initialize();
+        EXPECT_EQ(ConcurrencyElement::getMaxRunning(), 1);
+        my_sys.start();
+        auto system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::running);
+        for (const auto& part_name : participant_names)
+        {
+            auto state = my_sys.getParticipant(part_name).getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->getState();
+            ASSERT_EQ(state, fep3::rpc::ParticipantState::running);
+        }
+
+        // participants of one priority level are called concurrently without the limit
+        my_sys.stop();
+        my_sys.deinitialize();
+        my_sys.setHostConcurrency(0);
+        ConcurrencyElement::getMaxRunning() = 0;
+        my_sys.initialize();
+        EXPECT_GT(ConcurrencyElement::getMaxRunning(), 1);
+        EXPECT_LE(ConcurrencyElement::getMaxRunning(), 3);
+
+        my_sys.deinitialize();
+        my_sys.unload();
+        system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::unloaded);
+
+        // participants are shut down concurrently up to the limit
+        ASSERT_EQ(my_sys.getShutdownConcurrency(), static_cast<size_t>(FEP_SYSTEM_SHUTDOWN_CONCURRENCY));
+        my_sys.setShutdownConcurrency(2);
+        ASSERT_EQ(my_sys.getShutdownConcurrency(), 2u);
+        my_sys.shutdown();
+        for (const auto& part_name : participant_names)
+        {
+            auto state = my_sys.getParticipant(part_name).getRPCComponentProxyByIID<fep3::rpc::IRPCParticipantStateMachine>()->getState();
+            ASSERT_EQ(state, fep3::rpc::ParticipantState::unreachable);
+        }
+    }
+}
+
+/**
+ * Element which does not answer the initialization within the timeout of the transition
+ */
+struct BlockingElement : public TestElement
+{
+    fep3::Result initialize() override
+    {
+        a_util::system::sleepMilliseconds(2000);
+        return {};
+    }
+};
+
+TEST(SystemLibrary, TestControlSystemMissedDeadlineNOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_slow = "participant_slow";
+    const std::string part_name_fast = "participant_fast";
+
+    const auto slow_parts = createTestParticipants<BlockingElement>({ part_name_slow }, sys_name);
+    const auto fast_parts = createTestParticipants({ part_name_fast }, sys_name);
+
+    {
+        fep3::System my_sys(sys_name);
+        my_sys.add(part_name_slow);
+        my_sys.add(part_name_fast);
+        my_sys.load();
+
+        // the hung call is abandoned at the deadline, the participants of the same level are not waited for
+        const auto begin = std::chrono::steady_clock::now();
+        bool caught = false;
+        try
+        {
+            my_sys.initialize(std::chrono::milliseconds(500));
+        }
+        catch (const std::runtime_error& e)
+        {
+            const std::string msg = e.what();
+            EXPECT_NE(msg.find("no answer from participants: " + part_name_slow), std::string::npos) << msg;
+            EXPECT_EQ(msg.find(part_name_fast), std::string::npos) << msg;
+            caught = true;
+        }
+        const auto took = std::chrono::steady_clock::now() - begin;
+        ASSERT_TRUE(caught);
+        EXPECT_LT(took, std::chrono::milliseconds(1500));
+        auto state = my_sys.getParticipant(part_name_fast).getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->getState();
+        EXPECT_EQ(state, fep3::rpc::ParticipantState::initialized);
+
+        // the abandoned call is not cancelled at the participant
+        ASSERT_TRUE(my_sys.waitForParticipantState(part_name_slow, fep3::SystemAggregatedState::initialized,
+            std::chrono::milliseconds(3000)));
+        my_sys.deinitialize();
+        my_sys.unload();
+    }
+}
+
+TEST(SystemLibrary, TestControlSystemAsyncOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1, part_name_2 };
+    const auto test_parts = createTestParticipants(participant_names, sys_name);
+
+    {
+        fep3::System my_sys(sys_name);
+        my_sys.add(part_name_1);
+        my_sys.add(part_name_2);
+
+        auto operation = my_sys.setSystemStateAsync(fep3::SystemAggregatedState::running);
+        ASSERT_TRUE(operation);
+        ASSERT_TRUE(operation.waitFor(std::chrono::milliseconds(20000)));
+        ASSERT_NO_THROW(operation.get());
+        auto progress = operation.getParticipantProgress();
+        ASSERT_EQ(progress.size(), 2u);
+        ASSERT_EQ(progress[0]._participant_name, part_name_1);
+        ASSERT_EQ(progress[0]._status, fep3::ParticipantProgress::Status::done);
+        ASSERT_EQ(progress[1]._participant_name, part_name_2);
+        ASSERT_EQ(progress[1]._status, fep3::ParticipantProgress::Status::done);
+
+        auto system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::running);
+
+        operation = my_sys.stopAsync();
+        operation.wait();
+        ASSERT_TRUE(operation.isDone());
+        ASSERT_NO_THROW(operation.get());
+
+        // a declined transition is reported by the operation
+        operation = my_sys.startAsync();
+        ASSERT_NO_THROW(operation.get());
+        operation = my_sys.loadAsync();
+        ASSERT_ANY_THROW(operation.get());
+        progress = operation.getParticipantProgress();
+        ASSERT_EQ(progress[0]._status, fep3::ParticipantProgress::Status::failed);
+        ASSERT_FALSE(progress[0]._error_message.empty());
+
+        my_sys.setSystemState(fep3::SystemAggregatedState::unloaded);
+
+        // a cancelled operation is finished immediately
+        operation = my_sys.loadAsync();
+        operation.cancel();
+        ASSERT_TRUE(operation.isDone());
+    }
+}
+
+TEST(SystemLibrary, TestControlSystemDependenciesOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const auto participant_names = std::vector<std::string>{ "participant1", "participant2", "participant3" };
+    const auto test_parts = createTestParticipants(participant_names, sys_name);
+
+    {
+        fep3::System my_sys(sys_name);
+        for (const auto& part_name : participant_names)
+        {
+            my_sys.add(part_name);
+        }
+        // participant1 feeds the others, participants which are not within the system are ignored
+        my_sys.getParticipant("participant2").setInitDependencies({ "participant1", "does_not_exist" });
+        my_sys.getParticipant("participant3").setInitDependencies({ "participant1" });
+        my_sys.getParticipant("participant3").setStartDependencies({ "participant2" });
+        ASSERT_EQ(my_sys.getParticipant("participant2").getInitDependencies(),
+            std::vector<std::string>({ "participant1", "does_not_exist" }));
+        ASSERT_EQ(my_sys.getParticipant("participant3").getStartDependencies(),
+            std::vector<std::string>({ "participant2" }));
+
+        my_sys.setSystemState(fep3::SystemAggregatedState::running);
+        auto system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::running);
+
+        my_sys.setSystemState(fep3::SystemAggregatedState::loaded);
+
+        // a cycle can not be ordered
+        my_sys.getParticipant("participant1").setInitDependencies({ "participant3" });
+        ASSERT_ANY_THROW(my_sys.unload());
+        system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::loaded);
+
+        my_sys.getParticipant("participant1").setInitDependencies({});
+        my_sys.unload();
+        my_sys.shutdown();
+    }
+}
+
+TEST(SystemLibrary, TestConvergeSystemStateOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1, part_name_2 };
+    const auto test_parts = createTestParticipants(participant_names, sys_name);
+
+    {
+        fep3::System my_sys(sys_name);
+        my_sys.add(part_name_1);
+        my_sys.add(part_name_2);
+        my_sys.setSystemState(fep3::SystemAggregatedState::running);
+
+        // participant2 falls back (i.e. it was restarted), the system is not homogenous anymore
+        auto p2 = my_sys.getParticipant(part_name_2);
+        p2.getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->stop();
+        p2.getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->deinitialize();
+        auto system_state = my_sys.getSystemState();
+        ASSERT_FALSE(system_state._homogeneous);
+        ASSERT_ANY_THROW(my_sys.setSystemState(fep3::SystemAggregatedState::running));
+
+        // every participant takes its own path
+        ASSERT_NO_THROW(my_sys.convergeSystemState(fep3::SystemAggregatedState::running));
+        system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::running);
+
+        // participants going down and up at the same time
+        p2.getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->stop();
+        p2.getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->deinitialize();
+        p2.getRPCComponentProxy<fep3::rpc::IRPCParticipantStateMachine>()->unload();
+        auto operation = my_sys.convergeSystemStateAsync(fep3::SystemAggregatedState::initialized);
+        ASSERT_NO_THROW(operation.get());
+        system_state = my_sys.getSystemState();
+        ASSERT_TRUE(system_state._homogeneous);
+        ASSERT_EQ(system_state._state, fep3::SystemAggregatedState::initialized);
+
+        my_sys.convergeSystemState(fep3::SystemAggregatedState::unloaded);
+        my_sys.shutdown();
+    }
+}
+
 TEST(SystemLibrary, TestMonitorSystemOK)
 {
     const std::string sys_name = makePlatformDepName("system_under_test");
@@ -491,6 +971,402 @@ TEST(SystemLibrary, TestMonitorSystemOK)
     }
 }
 
+TEST(SystemLibrary, TestHealthMonitorOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1, part_name_2 };
+
+    {
+        auto test_parts = createTestParticipants(participant_names, sys_name);
+        TestEventMonitor tem(sys_name);
+        fep3::System my_sys(sys_name);
+        my_sys.registerMonitoring(tem);
+        my_sys.add(part_name_1);
+        my_sys.add(part_name_2);
+
+        ASSERT_FALSE(my_sys.getHealthMonitor());
+        my_sys.setHealthMonitor(true, std::chrono::milliseconds(100), std::chrono::milliseconds(400));
+        ASSERT_TRUE(my_sys.getHealthMonitor());
+
+        // participant2 dies without any call of the system
+        test_parts.erase(part_name_2);
+        EXPECT_TRUE(tem.waitFor("Participant " + part_name_2 + " of system " + sys_name + " is unreachable", 5000));
+        ASSERT_EQ(tem._severity_level, fep3::logging::Severity::error);
+        EXPECT_TRUE(tem.waitForReachability(part_name_2, false));
+
+        my_sys.setHealthMonitor(false);
+        // unregister monitoring is important!
+        my_sys.unregisterMonitoring(tem);
+    }
+}
+
+/**
+ * @detail Test the latency history of the transitions
+ */
+TEST(SystemLibrary, TestTransitionLatenciesOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1, part_name_2 };
+
+    auto test_parts = createTestParticipants(participant_names, sys_name);
+    fep3::System my_sys(sys_name);
+    my_sys.add(part_name_1);
+    my_sys.add(part_name_2);
+    ASSERT_EQ(my_sys.getTransitionLatencies("start")._count, 0u);
+    ASSERT_THROW(my_sys.getTransitionLatencies("jump"), std::runtime_error);
+
+    for (int round = 0; round < 2; ++round)
+    {
+        my_sys.load();
+        my_sys.initialize();
+        my_sys.start();
+        my_sys.stop();
+        my_sys.deinitialize();
+        my_sys.unload();
+    }
+
+    const auto latencies = my_sys.getTransitionLatencies("start", 1);
+    EXPECT_EQ(latencies._count, 4u);
+    EXPECT_LE(latencies._p50, latencies._p90);
+    EXPECT_LE(latencies._p99, latencies._max);
+    ASSERT_EQ(latencies._slowest.size(), 1u);
+    EXPECT_EQ(latencies._slowest[0]._count, 2u);
+    EXPECT_GE(latencies._slowest[0]._p90, my_sys.getTransitionLatencies("start", 2)._slowest[1]._p90);
+
+    my_sys.remove(part_name_2);
+    EXPECT_EQ(my_sys.getTransitionLatencies("load", 2)._slowest.size(), 1u);
+    my_sys.clearTransitionLatencies();
+    EXPECT_EQ(my_sys.getTransitionLatencies("load")._count, 0u);
+}
+
+TEST(SystemLibrary, TestAdaptiveTimeoutsOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    const auto participant_names = std::vector<std::string>{ part_name_1, part_name_2 };
+
+    auto test_parts = createTestParticipants(participant_names, sys_name);
+    {
+        fep3::System my_sys(sys_name);
+        my_sys.add(part_name_1);
+        my_sys.add(part_name_2);
+        EXPECT_FALSE(my_sys.getAdaptiveTimeouts());
+        my_sys.setAdaptiveTimeouts(true, 2.0, std::chrono::milliseconds(500), std::chrono::milliseconds(5000));
+        EXPECT_TRUE(my_sys.getAdaptiveTimeouts());
+        EXPECT_TRUE(fep3::System(my_sys).getAdaptiveTimeouts());
+        ASSERT_THROW(my_sys.getAdaptiveTimeout(part_name_1, "jump"), std::runtime_error);
+        EXPECT_EQ(my_sys.getAdaptiveTimeout(part_name_1, "load").count(), 0);
+
+        for (int round = 0; round < FEP_SYSTEM_ADAPTIVE_TIMEOUT_MIN_CALLS; ++round)
+        {
+            ASSERT_NO_THROW(my_sys.load());
+            ASSERT_NO_THROW(my_sys.unload());
+        }
+        EXPECT_GE(my_sys.getAdaptiveTimeout(part_name_1, "load"), std::chrono::milliseconds(500));
+        EXPECT_LE(my_sys.getAdaptiveTimeout(part_name_1, "load"), std::chrono::milliseconds(5000));
+        EXPECT_EQ(my_sys.getAdaptiveTimeout(part_name_1, "start").count(), 0);
+
+        //the latencies are kept by clearing the transition latencies and shared with the copies
+        my_sys.clearTransitionLatencies();
+        EXPECT_GE(my_sys.getAdaptiveTimeout(part_name_2, "unload"), std::chrono::milliseconds(500));
+        EXPECT_GE(fep3::System(my_sys).getAdaptiveTimeout(part_name_2, "unload"), std::chrono::milliseconds(500));
+    }
+
+    //the latencies are learned per process, a new system of the same name and url starts with them
+    fep3::System my_sys(sys_name);
+    EXPECT_FALSE(my_sys.getAdaptiveTimeouts());
+    EXPECT_GE(my_sys.getAdaptiveTimeout(part_name_2, "unload"), FEP_SYSTEM_ADAPTIVE_TIMEOUT_FLOOR);
+    EXPECT_LE(my_sys.getAdaptiveTimeout(part_name_2, "unload"), FEP_SYSTEM_ADAPTIVE_TIMEOUT_CEILING);
+
+    //but a system of another name does not
+    fep3::System other_sys(makePlatformDepName("other_system_under_test"));
+    EXPECT_EQ(other_sys.getAdaptiveTimeout(part_name_2, "unload").count(), 0);
+}
+
+class TransitionProgressMonitor : public fep3::IEventMonitor
+{
+public:
+    void onLog(std::chrono::milliseconds,
+        fep3::logging::Severity,
+        const std::string&,
+        const std::string&,
+        const std::string&) override
+    {
+    }
+
+    void onTransitionStarted(const std::string& transition, size_t participant_count) override
+    {
+        //blocks the delivery of the events until the transition returned
+        _transition_returned.wait_for(std::chrono::seconds(10));
+        addEvent("started " + transition + " " + std::to_string(participant_count));
+    }
+
+    void onParticipantTransitionFinished(const std::string& transition,
+        const std::string& participant_name,
+        bool successful,
+        std::chrono::microseconds,
+        size_t finished_count,
+        size_t participant_count) override
+    {
+        addEvent(transition + " " + participant_name + (successful ? " ok " : " failed ")
+            + std::to_string(finished_count) + "/" + std::to_string(participant_count));
+    }
+
+    void onTransitionFinished(const std::string& transition, bool successful, std::chrono::microseconds) override
+    {
+        addEvent("finished " + transition + (successful ? " ok" : " failed"));
+    }
+
+    std::vector<std::string> waitForEvents(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(_sync);
+        _events_changed.wait_for(lock, std::chrono::seconds(10), [&]() { return _events.size() >= count; });
+        return _events;
+    }
+
+    std::shared_future<void> _transition_returned;
+
+private:
+    void addEvent(const std::string& event)
+    {
+        std::lock_guard<std::mutex> lock(_sync);
+        _events.push_back(event);
+        _events_changed.notify_all();
+    }
+
+    std::vector<std::string> _events;
+    std::mutex _sync;
+    std::condition_variable _events_changed;
+};
+
+/**
+ * @detail Test the progress events of a transition.
+ * The delivery of the events is blocked until the transition returned, so they have to be asynchronous.
+ */
+TEST(SystemLibrary, TestTransitionProgressEventsOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+
+    auto test_parts = createTestParticipants({ part_name_1 }, sys_name);
+    fep3::System my_sys(sys_name);
+    my_sys.add(part_name_1);
+
+    TransitionProgressMonitor monitor;
+    std::promise<void> transition_returned;
+    monitor._transition_returned = transition_returned.get_future().share();
+    my_sys.registerMonitoring(monitor);
+
+    const auto load_begin = std::chrono::steady_clock::now();
+    my_sys.load();
+    EXPECT_LT(std::chrono::steady_clock::now() - load_begin, std::chrono::seconds(10));
+    transition_returned.set_value();
+
+    const auto events = monitor.waitForEvents(3);
+    const auto expected_events = std::vector<std::string>{
+        "started load 1",
+        "load " + part_name_1 + " ok 1/1",
+        "finished load ok" };
+    EXPECT_EQ(events, expected_events);
+
+    my_sys.unregisterMonitoring(monitor);
+    my_sys.unload();
+}
+
+/**
+ * @detail Test the order of the participants within the transitions, it follows priority changes between the transitions.
+ * The participants are added with their urls (all on this host), with one call per host at a time
+ * the participants of one priority level are called one after the other.
+ */
+TEST(SystemLibrary, TestPriorityOrderOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const auto participant_names = std::vector<std::string>{ "participant1", "participant2", "participant3" };
+
+    auto test_parts = createTestParticipants(participant_names, sys_name);
+    std::multimap<std::string, std::string> participant_urls;
+    {
+        const auto discovered_sys = fep3::discoverSystem(sys_name);
+        for (const auto& part_name : participant_names)
+        {
+            participant_urls.emplace(part_name, discovered_sys.getParticipant(part_name).getUrl());
+        }
+    }
+    fep3::System my_sys(sys_name);
+    my_sys.add(participant_urls);
+    for (const auto& participant_url : participant_urls)
+    {
+        ASSERT_FALSE(participant_url.second.empty());
+    }
+    my_sys.setHostConcurrency(1);
+    my_sys.getParticipant("participant2").setInitPriority(1);
+
+    TransitionProgressMonitor monitor;
+    std::promise<void> transition_returned;
+    monitor._transition_returned = transition_returned.get_future().share();
+    transition_returned.set_value();
+    my_sys.registerMonitoring(monitor);
+
+    //the highest priority first, the participants of one priority in the order they were added
+    my_sys.load();
+    //the lowest priority first, the participants of one priority in the reverse order
+    my_sys.unload();
+    my_sys.getParticipant("participant1").setInitPriority(2);
+    my_sys.load();
+
+    const auto events = monitor.waitForEvents(15);
+    const auto expected_events = std::vector<std::string>{
+        "started load 3",
+        "load participant2 ok 1/3",
+        "load participant1 ok 2/3",
+        "load participant3 ok 3/3",
+        "finished load ok",
+        "started unload 3",
+        "unload participant3 ok 1/3",
+        "unload participant1 ok 2/3",
+        "unload participant2 ok 3/3",
+        "finished unload ok",
+        "started load 3",
+        "load participant1 ok 1/3",
+        "load participant2 ok 2/3",
+        "load participant3 ok 3/3",
+        "finished load ok" };
+    EXPECT_EQ(events, expected_events);
+
+    my_sys.unregisterMonitoring(monitor);
+    my_sys.unload();
+}
+
+/**
+ * @detail Test the Chrome trace of the system operations and of the calls of the participants.
+ */
+TEST(SystemLibrary, TestTracingOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+
+    auto test_parts = createTestParticipants({ part_name_1 }, sys_name);
+    fep3::System my_sys(sys_name);
+    my_sys.add(part_name_1);
+
+    fep3::startTracing();
+    my_sys.load();
+    fep3::stopTracing();
+    my_sys.unload();
+
+    const auto trace = fep3::getTrace();
+    EXPECT_EQ(trace.find("{\"traceEvents\":["), 0u);
+    EXPECT_NE(trace.find("\"name\":\"system " + sys_name + "\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"" + part_name_1 + "\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"load\",\"cat\":\"operation\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"load\",\"cat\":\"call\""), std::string::npos);
+    //recorded after stopTracing
+    EXPECT_EQ(trace.find("\"name\":\"unload\""), std::string::npos);
+
+    ASSERT_THROW(fep3::writeTrace("not_existing_directory/trace.json"), std::runtime_error);
+}
+
+/**
+ * @detail Test the bulk add of participants, the participants are added in the given order and all or none.
+ */
+TEST(SystemLibrary, TestBulkAddOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::vector<std::string> part_names = { "participant1", "participant2", "participant3" };
+
+    auto test_parts = createTestParticipants(part_names, sys_name);
+    fep3::System my_sys(sys_name);
+    my_sys.add(part_names);
+
+    auto participants = my_sys.getParticipants();
+    ASSERT_EQ(participants.size(), part_names.size());
+    for (size_t index = 0; index < part_names.size(); ++index)
+    {
+        EXPECT_EQ(participants[index].getName(), part_names[index]);
+    }
+
+    ASSERT_THROW(my_sys.add(std::vector<std::string>{ "participant4", part_names[0] }), std::runtime_error);
+    ASSERT_THROW(my_sys.add(std::vector<std::string>{ "participant4", "participant4" }), std::runtime_error);
+    EXPECT_EQ(my_sys.getParticipants().size(), part_names.size());
+    ASSERT_THROW(my_sys.getParticipant("participant4"), std::runtime_error);
+}
+
+/**
+ * @detail Test the lazy connection of participants, an unreachable participant can be added without any request.
+ */
+TEST(SystemLibrary, TestLazyConnectionOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+
+    auto test_parts = createTestParticipants({ part_name_1 }, sys_name);
+    fep3::System my_sys(sys_name);
+    ASSERT_FALSE(my_sys.getLazyConnection());
+    my_sys.setLazyConnection(true);
+    ASSERT_TRUE(my_sys.getLazyConnection());
+
+    my_sys.add(part_name_1);
+    ASSERT_NO_THROW(my_sys.add("not_existing_participant"));
+    my_sys.remove("not_existing_participant");
+
+    //the first use connects the participant
+    my_sys.load();
+    ASSERT_EQ(my_sys.getSystemState()._state, fep3::System::AggregatedState::loaded);
+    my_sys.unload();
+
+    fep3::System copied_sys(my_sys);
+    ASSERT_TRUE(copied_sys.getLazyConnection());
+}
+
+/**
+ * @detail Test the copies of a system, they share the connections to the participants but not the participants.
+ */
+TEST(SystemLibrary, TestCopySharedConnectionsOK)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+
+    auto test_parts = createTestParticipants({ part_name_1, part_name_2 }, sys_name);
+    std::unique_ptr<fep3::System> original_sys(new fep3::System(sys_name));
+    original_sys->add(part_name_1);
+    original_sys->add(part_name_2);
+    original_sys->getParticipant(part_name_1).setInitPriority(5);
+
+    fep3::System copied_sys(*original_sys);
+    ASSERT_EQ(copied_sys.getParticipant(part_name_1).getInitPriority(), 5);
+    copied_sys.getParticipant(part_name_1).setInitPriority(7);
+    EXPECT_EQ(original_sys->getParticipant(part_name_1).getInitPriority(), 5);
+    copied_sys.remove(part_name_2);
+    EXPECT_EQ(original_sys->getParticipants().size(), 2u);
+
+    //an assignment replaces the participants of the target, also if they have the same names
+    fep3::System assigned_sys(sys_name);
+    assigned_sys.add(part_name_1);
+    assigned_sys = copied_sys;
+    ASSERT_EQ(assigned_sys.getParticipants().size(), 1u);
+    EXPECT_EQ(assigned_sys.getParticipant(part_name_1).getInitPriority(), 7);
+    assigned_sys = *original_sys;
+    EXPECT_EQ(assigned_sys.getParticipants().size(), 2u);
+    EXPECT_EQ(assigned_sys.getParticipant(part_name_1).getInitPriority(), 5);
+
+    //the copy keeps the connection alive
+    original_sys.reset();
+    copied_sys.load();
+    ASSERT_EQ(copied_sys.getSystemState()._state, fep3::System::AggregatedState::loaded);
+    copied_sys.unload();
+
+    EXPECT_FALSE(fep3::ParticipantProxy().copyWithSharedConnection());
+}
+
 TEST(SystemLibrary, TestGetAClock)
 {
     const std::string sys_name = makePlatformDepName("system_under_test");
@@ -584,6 +1460,47 @@ TEST(SystemLibrary, getTimingPropertiesRealTime)
     EXPECT_EQ(properties.getPropertyType(FEP3_SCHEDULER_PROPERTY), string_type);
 }
 
+TEST(SystemLibrary, getTimingPropertiesCoalescedAndCached)
+{
+    const std::string sys_name = makePlatformDepName("system_under_test");
+    const std::string part_name = "participant";
+
+    const auto participant_names = std::vector<std::string>{ part_name };
+
+    auto test_parts = createTestParticipants(participant_names, sys_name);
+    fep3::System my_sys(sys_name);
+    my_sys.add(part_name);
+    my_sys.load();
+
+    auto props_part = my_sys.getParticipant(part_name).getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>()->getProperties("/");
+    const std::string string_type = fep3::PropertyType<std::string>::getTypeName();
+    props_part->setProperty(FEP3_CLOCK_SERVICE_MAIN_CLOCK, FEP3_CLOCK_LOCAL_SYSTEM_REAL_TIME, string_type);
+
+    // concurrent calls share one request, every caller gets its own copy
+    std::vector<std::future<std::map<std::string, std::unique_ptr<fep3::IProperties>>>> results;
+    for (int call = 0; call < 4; ++call)
+    {
+        results.push_back(std::async(std::launch::async, [&my_sys]() { return my_sys.getTimingProperties(); }));
+    }
+    for (auto& result : results)
+    {
+        auto timing_properties = result.get();
+        ASSERT_EQ(timing_properties.size(), 1u);
+        EXPECT_EQ(timing_properties.at(part_name)->getProperty(FEP3_MAIN_CLOCK_PROPERTY), FEP3_CLOCK_LOCAL_SYSTEM_REAL_TIME);
+    }
+
+    // a cached result does not see the change at the participant
+    ASSERT_EQ(my_sys.getQueryCache(), std::chrono::milliseconds(0));
+    my_sys.setQueryCache(std::chrono::milliseconds(10000));
+    ASSERT_EQ(my_sys.getQueryCache(), std::chrono::milliseconds(10000));
+    my_sys.getTimingProperties();
+    props_part->setProperty(FEP3_CLOCK_SERVICE_MAIN_CLOCK, FEP3_CLOCK_LOCAL_SYSTEM_SIM_TIME, string_type);
+    EXPECT_EQ(my_sys.getTimingProperties().at(part_name)->getProperty(FEP3_MAIN_CLOCK_PROPERTY), FEP3_CLOCK_LOCAL_SYSTEM_REAL_TIME);
+
+    my_sys.setQueryCache(std::chrono::milliseconds(0));
+    EXPECT_EQ(my_sys.getTimingProperties().at(part_name)->getProperty(FEP3_MAIN_CLOCK_PROPERTY), FEP3_CLOCK_LOCAL_SYSTEM_SIM_TIME);
+}
+
 TEST(SystemLibrary, getTimingPropertiesAFAP)
 {
     const std::string sys_name = makePlatformDepName("system_under_test");